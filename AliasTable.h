@@ -0,0 +1,174 @@
+#ifndef ALIAS_TABLE_H
+#define ALIAS_TABLE_H
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+#include "AlignedColumn.h"
+#include "Rng.h"
+#include "SimdBatch.h"
+
+namespace Game {
+
+    // Discrete distribution over weighted outcomes, sampled in O(1) with
+    // Vose's alias method. Each draw reads a single 16-byte entry.
+    class AliasTable {
+    public:
+        // Outcome i is drawn with probability weights[i] / sum(weights), and
+        // sample() returns ids[i] for it (or i when ids is empty).
+        void build(const std::vector<double>& weights, const std::vector<int32_t>& ids = {}) {
+            const size_t n = weights.size();
+            if (!ids.empty() && ids.size() != n) {
+                throw std::runtime_error("AliasTable: weights and ids must have the same length.");
+            }
+            double total = 0.0;
+            for (double w : weights) {
+                if (!(w >= 0.0)) throw std::runtime_error("AliasTable: weights must be non-negative.");
+                total += w;
+            }
+            m_entries.clear();
+            if (n == 0) return;
+            if (total <= 0.0) throw std::runtime_error("AliasTable: total weight must be positive.");
+
+            // Scale so the average bucket holds exactly 1, then pair each
+            // under-full bucket with an over-full one.
+            std::vector<double> scaled(n);
+            std::vector<size_t> small, large;
+            for (size_t i = 0; i < n; ++i) {
+                scaled[i] = weights[i] * n / total;
+                (scaled[i] < 1.0 ? small : large).push_back(i);
+            }
+
+            m_entries.resize(n);
+            for (size_t i = 0; i < n; ++i) {
+                const int32_t id = ids.empty() ? static_cast<int32_t>(i) : ids[i];
+                m_entries[i] = {1.0, id, id};
+            }
+            while (!small.empty() && !large.empty()) {
+                const size_t s = small.back(); small.pop_back();
+                const size_t l = large.back(); large.pop_back();
+                m_entries[s].prob = scaled[s];
+                m_entries[s].alias_id = m_entries[l].id;
+                scaled[l] = (scaled[l] + scaled[s]) - 1.0;
+                (scaled[l] < 1.0 ? small : large).push_back(l);
+            }
+            // Whatever is left is full up to rounding error.
+            for (size_t i : small) m_entries[i].prob = 1.0;
+            for (size_t i : large) m_entries[i].prob = 1.0;
+        }
+
+        bool empty() const { return m_entries.empty(); }
+        size_t size() const { return m_entries.size(); }
+
+        // One uniform draw picks the bucket (integer part) and the side of the
+        // split within it (fractional part).
+        template <typename Rng>
+        int32_t sample(Rng& rng) const {
+            const double u = uniformUnit(rng) * m_entries.size();
+            size_t i = static_cast<size_t>(u);
+            if (i >= m_entries.size()) i = m_entries.size() - 1;
+            const Entry& e = m_entries[i];
+            return (u - i) < e.prob ? e.id : e.alias_id;
+        }
+
+        /**
+         * @brief Batched form of sample(): maps n uniforms in [0, 1) to outcomes.
+         * out[i] is exactly what sample() returns for a draw of u[i], so a batch
+         * fed the same uniforms reproduces the scalar sequence. Uses AVX-512 or
+         * AVX2 gathers when the CPU supports them; SSE4.2 has no gathers, so
+         * older CPUs take the scalar loop.
+         */
+        void sampleBatch(const double* u, size_t n, int32_t* out) const {
+            if (m_entries.empty()) return;
+#if GAME_SIMD_X86
+            if (cpuHasAVX512()) {
+                sampleBatchAVX512(u, n, out);
+                return;
+            }
+            if (cpuHasAVX2()) {
+                sampleBatchAVX2(u, n, out);
+                return;
+            }
+#endif
+            sampleBatchScalar(u, n, out);
+        }
+
+    private:
+        struct Entry {
+            double prob;       // Chance of keeping this bucket's own outcome
+            int32_t id;        // Outcome owned by the bucket
+            int32_t alias_id;  // Outcome returned otherwise
+        };
+        static_assert(sizeof(Entry) == 16, "the SIMD paths gather Entry fields at fixed offsets");
+        AlignedColumn<Entry> m_entries;
+
+        void sampleBatchScalar(const double* u, size_t n, int32_t* out) const {
+            const size_t buckets = m_entries.size();
+            for (size_t k = 0; k < n; ++k) {
+                const double x = u[k] * buckets;
+                size_t i = static_cast<size_t>(x);
+                if (i >= buckets) i = buckets - 1;
+                const Entry& e = m_entries[i];
+                out[k] = (x - i) < e.prob ? e.id : e.alias_id;
+            }
+        }
+
+#if GAME_SIMD_X86
+        // Four draws per step: bucket index and fraction in double lanes,
+        // then gathers of prob (8-byte slots 2i) and id/alias (4-byte slots 4i+2, 4i+3).
+        __attribute__((target("avx2")))
+        void sampleBatchAVX2(const double* u, size_t n, int32_t* out) const {
+            const double* prob_base = reinterpret_cast<const double*>(m_entries.data());
+            const int* id_base = reinterpret_cast<const int*>(m_entries.data());
+            const __m256d vbuckets = _mm256_set1_pd(static_cast<double>(m_entries.size()));
+            const __m128i vlast = _mm_set1_epi32(static_cast<int>(m_entries.size() - 1));
+            const __m256d all_lanes = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+            size_t k = 0;
+            for (; k + 4 <= n; k += 4) {
+                const __m256d x = _mm256_mul_pd(_mm256_loadu_pd(u + k), vbuckets);
+                const __m128i i = _mm_min_epi32(_mm256_cvttpd_epi32(x), vlast);
+                const __m256d frac = _mm256_sub_pd(x, _mm256_cvtepi32_pd(i));
+                // Masked form with a zeroed source: the unmasked intrinsic reads an
+                // uninitialized register and trips -Wmaybe-uninitialized on GCC 12.
+                const __m256d prob = _mm256_mask_i32gather_pd(_mm256_setzero_pd(), prob_base, _mm_slli_epi32(i, 1), all_lanes, 8);
+                const __m128i slot = _mm_slli_epi32(i, 2);
+                const __m128i id = _mm_i32gather_epi32(id_base, _mm_add_epi32(slot, _mm_set1_epi32(2)), 4);
+                const __m128i alias = _mm_i32gather_epi32(id_base, _mm_add_epi32(slot, _mm_set1_epi32(3)), 4);
+                // Narrow the 64-bit compare mask to 32-bit lanes for the blend.
+                const __m256 keep = _mm256_castpd_ps(_mm256_cmp_pd(frac, prob, _CMP_LT_OQ));
+                const __m128i keep32 = _mm_castps_si128(_mm_shuffle_ps(
+                    _mm256_castps256_ps128(keep), _mm256_extractf128_ps(keep, 1), _MM_SHUFFLE(2, 0, 2, 0)));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + k), _mm_blendv_epi8(alias, id, keep32));
+            }
+            sampleBatchScalar(u + k, n - k, out + k);
+        }
+
+        // Eight draws per step. id and alias_id sit side by side, so one 64-bit
+        // gather (slot 2i+1) fetches both and the keep mask picks a half. The
+        // all-lanes maskz forms avoid GCC 12's uninitialized-source warnings.
+        __attribute__((target("avx512f")))
+        void sampleBatchAVX512(const double* u, size_t n, int32_t* out) const {
+            const double* base = reinterpret_cast<const double*>(m_entries.data());
+            const __m512d vbuckets = _mm512_set1_pd(static_cast<double>(m_entries.size()));
+            const __m256i vlast = _mm256_set1_epi32(static_cast<int>(m_entries.size() - 1));
+            size_t k = 0;
+            for (; k + 8 <= n; k += 8) {
+                const __m512d x = _mm512_mul_pd(_mm512_loadu_pd(u + k), vbuckets);
+                const __m256i i = _mm256_min_epi32(_mm512_maskz_cvttpd_epi32(0xFF, x), vlast);
+                const __m512d frac = _mm512_sub_pd(x, _mm512_maskz_cvtepi32_pd(0xFF, i));
+                const __m256i slot = _mm256_slli_epi32(i, 1);
+                const __m512d prob = _mm512_mask_i32gather_pd(_mm512_setzero_pd(), 0xFF, slot, base, 8);
+                const __m512i ids = _mm512_mask_i32gather_epi64(_mm512_setzero_si512(), 0xFF,
+                                                                _mm256_add_epi32(slot, _mm256_set1_epi32(1)), base, 8);
+                const __mmask8 keep = _mm512_cmp_pd_mask(frac, prob, _CMP_LT_OQ);
+                const __m512i chosen = _mm512_mask_blend_epi64(keep, _mm512_maskz_srli_epi64(0xFF, ids, 32), ids);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + k), _mm512_maskz_cvtepi64_epi32(0xFF, chosen));
+            }
+            sampleBatchScalar(u + k, n - k, out + k);
+        }
+#endif
+    };
+
+} // namespace Game
+
+#endif // ALIAS_TABLE_H
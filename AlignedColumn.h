@@ -0,0 +1,44 @@
+#ifndef ALIGNED_COLUMN_H
+#define ALIGNED_COLUMN_H
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+namespace Game {
+
+    // Cache line size assumed for column alignment.
+    constexpr std::size_t kCacheLineSize = 64;
+
+    // Minimal allocator returning storage aligned to Align bytes.
+    template <typename T, std::size_t Align = kCacheLineSize>
+    struct AlignedAllocator {
+        using value_type = T;
+
+        template <typename U>
+        struct rebind { using other = AlignedAllocator<U, Align>; };
+
+        AlignedAllocator() noexcept = default;
+        template <typename U>
+        AlignedAllocator(const AlignedAllocator<U, Align>&) noexcept {}
+
+        T* allocate(std::size_t n) {
+            return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Align)));
+        }
+        void deallocate(T* p, std::size_t) noexcept {
+            ::operator delete(p, std::align_val_t(Align));
+        }
+
+        template <typename U>
+        bool operator==(const AlignedAllocator<U, Align>&) const noexcept { return true; }
+        template <typename U>
+        bool operator!=(const AlignedAllocator<U, Align>&) const noexcept { return false; }
+    };
+
+    // One field of an item table stored contiguously, starting on its own cache line.
+    template <typename T>
+    using AlignedColumn = std::vector<T, AlignedAllocator<T>>;
+
+} // namespace Game
+
+#endif // ALIGNED_COLUMN_H
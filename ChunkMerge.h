@@ -0,0 +1,68 @@
+#ifndef CHUNK_MERGE_H
+#define CHUNK_MERGE_H
+
+#include <map>
+#include <mutex>
+#include <utility>
+
+namespace Game {
+
+    /**
+     * @brief Combines per-chunk results in an order fixed by the chunk indices
+     * alone, so the total is the same whichever thread finished which chunk,
+     * and whenever. T is any type with merge(const T&).
+     *
+     * The chunks [0, num_chunks) are the leaves of a binary tree. A node is
+     * formed as left.merge(right) as soon as both children are in; a child
+     * whose range lies wholly past num_chunks is empty and passes its sibling
+     * up unchanged. Only nodes still waiting for their sibling are held, a
+     * handful per run of consecutive chunks, so per-chunk results may be
+     * large tables where keeping one per chunk until the end would not fit.
+     */
+    template <typename T>
+    class ChunkOrderedMerge {
+    public:
+        explicit ChunkOrderedMerge(long long num_chunks) : m_num_chunks(num_chunks) {
+            while ((1LL << m_levels) < num_chunks) m_levels++;
+        }
+
+        // Hands in the result of one chunk. Safe to call from any thread; every
+        // chunk in [0, num_chunks) must be added exactly once.
+        void add(long long chunk, T&& value) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            long long index = chunk;
+            for (int level = 0; level < m_levels; ++level, index >>= 1) {
+                const long long sibling = index ^ 1;
+                if ((sibling << level) >= m_num_chunks) continue;  // Empty sibling
+
+                auto it = m_waiting.find({level, sibling});
+                if (it == m_waiting.end()) {
+                    m_waiting.emplace(std::make_pair(level, index), std::move(value));
+                    return;
+                }
+                if (sibling < index) {
+                    it->second.merge(value);
+                    value = std::move(it->second);
+                } else {
+                    value.merge(it->second);
+                }
+                m_waiting.erase(it);
+            }
+            m_total = std::move(value);
+        }
+
+        // Merged result of every chunk, once all of them have been added; a
+        // default T for a run without chunks.
+        const T& total() const { return m_total; }
+
+    private:
+        long long m_num_chunks;
+        int m_levels = 0;                                  // Tree height: 2^m_levels >= num_chunks
+        std::map<std::pair<int, long long>, T> m_waiting;  // (level, index) -> node waiting for its sibling
+        T m_total;
+        std::mutex m_mutex;
+    };
+
+} // namespace Game
+
+#endif // CHUNK_MERGE_H
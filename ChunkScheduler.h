@@ -0,0 +1,110 @@
+#ifndef CHUNK_SCHEDULER_H
+#define CHUNK_SCHEDULER_H
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include "AlignedColumn.h"
+
+namespace Game {
+
+    /**
+     * @brief Hands out the chunk indices [0, num_chunks) to the threads of a
+     * parallel region. Each thread starts with a contiguous share, taken from
+     * the front without touching any other thread's cache line. A thread that
+     * runs dry steals the back half of the largest remaining share, so a few
+     * chunks that hit long FG sessions do not leave the other threads idle.
+     *
+     * A share is a [begin, end) pair packed into one atomic word: the owner
+     * advances begin and thieves lower end, both by compare-and-swap. A chunk
+     * leaves every share once it is claimed, so a share never returns to an
+     * earlier value and the swaps cannot be fooled by a stale read. Only chunk
+     * indices travel through the shares; results written by a chunk are
+     * published by the barrier that ends the parallel region.
+     */
+    class ChunkScheduler {
+    public:
+        // Throws std::runtime_error when num_chunks does not fit the 32-bit
+        // packed range. Runners call it before their parallel region, since
+        // reset() runs inside the region, where no exception may escape.
+        static void checkChunkCount(long long num_chunks) {
+            if (num_chunks < 0 || num_chunks > static_cast<long long>(UINT32_MAX)) {
+                throw std::runtime_error("ChunkScheduler: chunk count must be between 0 and 2^32 - 1.");
+            }
+        }
+
+        // Splits [0, num_chunks) evenly over num_threads shares. Must not run
+        // concurrently with next(). num_chunks must pass checkChunkCount and
+        // num_threads be at least 1.
+        void reset(long long num_chunks, int num_threads) {
+            assert(num_chunks >= 0 && num_chunks <= static_cast<long long>(UINT32_MAX));
+            assert(num_threads >= 1);
+            m_shares.reset(new Share[num_threads]);
+            m_num_threads = num_threads;
+            for (int t = 0; t < num_threads; ++t) {
+                const uint64_t begin = static_cast<uint64_t>(num_chunks) * t / num_threads;
+                const uint64_t end = static_cast<uint64_t>(num_chunks) * (t + 1) / num_threads;
+                m_shares[t].range.store(pack(begin, end), std::memory_order_relaxed);
+            }
+        }
+
+        // Claims the next chunk for thread_id. Returns false once every share
+        // is empty.
+        bool next(int thread_id, long long& chunk) {
+            std::atomic<uint64_t>& own = m_shares[thread_id].range;
+            uint64_t r = own.load(std::memory_order_relaxed);
+            while (begin(r) < end(r)) {
+                if (own.compare_exchange_weak(r, pack(begin(r) + 1, end(r)), std::memory_order_relaxed)) {
+                    chunk = static_cast<long long>(begin(r));
+                    return true;
+                }
+            }
+            return steal(thread_id, chunk);
+        }
+
+    private:
+        struct alignas(kCacheLineSize) Share {
+            std::atomic<uint64_t> range{0};
+        };
+
+        static uint64_t pack(uint64_t begin, uint64_t end) { return (end << 32) | begin; }
+        static uint64_t begin(uint64_t r) { return r & 0xFFFFFFFFu; }
+        static uint64_t end(uint64_t r) { return r >> 32; }
+
+        // Takes the back half of the largest share, keeps its first chunk and
+        // makes the rest the thief's own share.
+        bool steal(int thread_id, long long& chunk) {
+            for (;;) {
+                int victim = -1;
+                uint64_t victim_range = 0, most = 0;
+                for (int t = 0; t < m_num_threads; ++t) {
+                    if (t == thread_id) continue;
+                    const uint64_t r = m_shares[t].range.load(std::memory_order_relaxed);
+                    if (end(r) > begin(r) && end(r) - begin(r) > most) {
+                        victim = t;
+                        victim_range = r;
+                        most = end(r) - begin(r);
+                    }
+                }
+                if (victim < 0) return false;
+
+                const uint64_t take = (most + 1) / 2;
+                const uint64_t split = end(victim_range) - take;
+                if (m_shares[victim].range.compare_exchange_strong(victim_range, pack(begin(victim_range), split),
+                                                                   std::memory_order_relaxed)) {
+                    m_shares[thread_id].range.store(pack(split + 1, end(victim_range)), std::memory_order_relaxed);
+                    chunk = static_cast<long long>(split);
+                    return true;
+                }
+            }
+        }
+
+        std::unique_ptr<Share[]> m_shares;
+        int m_num_threads = 0;
+    };
+
+} // namespace Game
+
+#endif // CHUNK_SCHEDULER_H
@@ -3,14 +3,22 @@
 #include <iostream>
 #include <vector>
 #include <numeric>
+#include <map>
+#include <tuple>
+#include <type_traits>
+#include <algorithm>
+#include <sstream>
+#include <cstddef>
+#include "RoundKernels.h"
+#include "FGRules.h"
 #include <fstream>
 #include "json.hpp"
-#include <atomic> // For safety, include here as well
+#include <atomic>
 
 // Use the nlohmann namespace for convenience
 using json = nlohmann::json;
 
-namespace Game {
+namespace Game::DeepDive {
 
     // --- Internal Game Data Storage ---
 
@@ -22,8 +30,33 @@ namespace Game {
     // JSON parsing that happened before the flag was set.
     static std::atomic<bool> isInitialized = false;
 
-    // Safety limit to prevent a single game round from using too much memory.
-    const size_t MAX_QUEUE_SIZE = 1000;
+    // Safety limit on the FG picks still owed in a single game round. A retrigger
+    // that finds more than this many picks owed is dropped and its picks are
+    // counted in fg_dropped_picks; the session goes on draining what it owes.
+    const size_t MAX_PENDING_PICKS = 1000;
+
+    // DeepDive's own FG rules: a flagged BG item or FG pick grants 10 picks,
+    // as does a second chance, and each FG pick pays its value times the sum
+    // of `count` draws from its multiplier pool. Levels carry no multiplier.
+    // FG_ONLY rounds start the way FULL_GAME rounds enter FG.
+    static FGRules defaultFGRules() {
+        FGRules rules;
+        rules.trigger = PickRule::FIXED;
+        rules.trigger_picks = 10;
+        rules.retrigger = PickRule::FIXED;
+        rules.retrigger_picks = 10;
+        rules.second_chance_picks = 10;
+        rules.multiplier = MultiplierRule::POOL_SUM;
+        rules.bg_level_multipliers = {{1}};
+        rules.fg_level_multipliers = {{1}};
+        return rules;
+    }
+
+    // Rules of the loaded game; overridden by the config's "fg_rules" block.
+    static FGRules fgRules = defaultFGRules();
+
+    // FG_ONLY start distribution, resolved from fgRules and the BG table at load.
+    static FGOnlyStartTable fgOnlyStart;
 
         const DeepDiveData& getGameData() {
         if (!isInitialized) {
@@ -33,15 +66,126 @@ namespace Game {
     }
 
 
+    // Session cache indexed by initial pick count; empty when disabled.
+    static FGSessionCache fgSessionCache;
+
     // Helper to clear data before loading
     static void clearGameData() {
         gameData.bg_items.clear();
         gameData.fg_items.clear();
         gameData.multiplier_pools.clear();
         gameData.item_to_pool_map.clear();
+        gameData.columns = ItemColumns();
+        fgRules = defaultFGRules();
+        fgOnlyStart = FGOnlyStartTable();
+        fgSessionCache.clear();
         isInitialized = false;
     }
 
+    static long long poolTotalWeight(const MultiplierPool& pool) {
+        long long total = 0;
+        for (const PoolEntry& entry : pool) total += entry.weight;
+        return total;
+    }
+
+    // Returns the multiplier pool an FG item draws from, or -1 if it has no
+    // multiplier symbols. Throws on a mapping the FG loop could not use.
+    static int32_t resolveMultiplierPool(const FG_Item& item) {
+        const std::string where = "FG Item index " + std::to_string(item.index);
+        if (item.count < 0) {
+            throw std::runtime_error(where + " has a negative multiplier count.");
+        }
+        if (item.count == 0) return -1;
+
+        auto map_it = gameData.item_to_pool_map.find(item.index);
+        if (map_it == gameData.item_to_pool_map.end()) {
+            throw std::runtime_error(where + " has count " + std::to_string(item.count) + " but no entry in item_to_pool_map.");
+        }
+        const int pool_id = map_it->second;
+        if (pool_id < 0 || pool_id >= static_cast<int>(gameData.multiplier_pools.size())) {
+            throw std::runtime_error(where + " maps to multiplier pool " + std::to_string(pool_id) + ", which does not exist.");
+        }
+        if (poolTotalWeight(gameData.multiplier_pools[pool_id]) <= 0) {
+            throw std::runtime_error(where + " maps to multiplier pool " + std::to_string(pool_id) + ", which is empty.");
+        }
+        return pool_id;
+    }
+
+    // Convolves the pool with itself count times.
+    std::map<long long, double> multiplierSumDistribution(const MultiplierPool& pool, int count) {
+        const double total_weight = static_cast<double>(poolTotalWeight(pool));
+        std::map<long long, double> single;
+        for (const PoolEntry& entry : pool) {
+            if (entry.weight > 0) single[entry.value] += entry.weight / total_weight;
+        }
+
+        std::map<long long, double> total = {{0, 1.0}};
+        for (int c = 0; c < count; ++c) {
+            std::map<long long, double> next;
+            for (const auto& [sum, p] : total) {
+                for (const auto& [value, q] : single) next[sum + value] += p * q;
+            }
+            total.swap(next);
+        }
+        return total;
+    }
+
+    // The distinct totals of count draws from a pool and an alias table over them.
+    static MultiplierSumTable buildMultiplierSumTable(int pool_id, int count) {
+        MultiplierSumTable table{pool_id, count, {}, {}};
+        std::vector<double> probs;
+        for (const auto& [sum, p] : multiplierSumDistribution(gameData.multiplier_pools[pool_id], count)) {
+            table.sums.push_back(sum);
+            probs.push_back(p);
+        }
+        table.sampler.build(probs);
+        return table;
+    }
+
+    // Rebuilds the SoA item columns from bg_items/fg_items. Called once at the
+    // end of every initializer, before isInitialized is set. The FG rules are
+    // applied here: pick counts, level multipliers and pool tables are
+    // resolved per row.
+    static void buildItemColumns() {
+        ItemColumns& cols = gameData.columns;
+        cols = ItemColumns();
+
+        buildBGClasses(gameData.bg_items, fgRules, [](const BG_Item& item) { return item.flag ? 1 : 0; }, cols, fgOnlyStart);
+
+        const size_t num_fg = gameData.fg_items.size();
+        cols.fg_value.resize(num_fg);
+        cols.fg_retrigger_picks.resize(num_fg);
+        cols.fg_count.resize(num_fg);
+        cols.fg_levels.resize(num_fg);
+        cols.fg_multiplier.resize(num_fg);
+        cols.fg_pool.resize(num_fg);
+        cols.fg_sum_table.resize(num_fg);
+        std::map<std::pair<int, int>, int32_t> sum_table_of;
+        std::vector<double> fg_weight(num_fg);
+        for (size_t i = 0; i < num_fg; ++i) {
+            const FG_Item& item = gameData.fg_items[i];
+            cols.fg_value[i] = item.value;
+            cols.fg_retrigger_picks[i] = fgRules.retriggerPicks(item.flag ? 1 : 0);
+            cols.fg_count[i] = item.count;
+            cols.fg_levels[i] = item.levels;
+            cols.fg_multiplier[i] = fgRules.fg_level_multipliers.at(item.levels);
+            // Under the in-value rule pools are ignored, so no row draws from one.
+            cols.fg_pool[i] = fgRules.multiplier == MultiplierRule::POOL_SUM ? resolveMultiplierPool(item) : -1;
+            cols.fg_sum_table[i] = -1;
+            if (cols.fg_pool[i] >= 0) {
+                const auto key = std::make_pair(cols.fg_pool[i], item.count);
+                auto it = sum_table_of.find(key);
+                if (it == sum_table_of.end()) {
+                    it = sum_table_of.emplace(key, static_cast<int32_t>(cols.multiplier_sums.size())).first;
+                    cols.multiplier_sums.push_back(buildMultiplierSumTable(key.first, key.second));
+                }
+                cols.fg_sum_table[i] = it->second;
+            }
+            fg_weight[i] = item.weight;
+        }
+        cols.fg_sampler.build(fg_weight);
+    }
+
     void initializeWithSampleData() {
         clearGameData();
         std::cout << "Initializing DeepDive game data with hardcoded samples..." << std::endl;
@@ -55,13 +199,14 @@ namespace Game {
             {205, 50, true, 4, 2}
         };
         gameData.multiplier_pools = {
-            {1, 2, 3, 5, 10},
-            {1, 1, 1, 3, 10}
+            {{1, 1}, {2, 1}, {3, 1}, {5, 1}, {10, 1}},
+            {{1, 3}, {3, 1}, {10, 1}}
         };
         gameData.item_to_pool_map = {
             {201, 0}, {202, 1}, {203, 1}, {205, 0}
         };
 
+        buildItemColumns();
         isInitialized = true; // This write is now an atomic operation
         std::cout << "Sample data initialization complete." << std::endl;
     }
@@ -109,7 +254,8 @@ void initializeFromJSON(const std::string& filename, double bg_value_factor, dou
                             static_cast<int>(item.at("value").get<double>() * fg_value_factor), // Apply factor and cast
                             item.at("flag").get<bool>(),
                             item.at("count").get<int>(),
-                            item.at("levels").get<int>()
+                            item.at("levels").get<int>(),
+                            item.value("weight", 1)
                         });
                     }
                 } else if (fg_items_json[0].is_array()) {
@@ -119,17 +265,34 @@ void initializeFromJSON(const std::string& filename, double bg_value_factor, dou
                             static_cast<int>(item_arr.at(1).get<double>() * fg_value_factor), // Apply factor and cast
                             item_arr.at(2).get<int>() == 1,
                             item_arr.at(3).get<int>(),
-                            item_arr.at(4).get<int>()
+                            item_arr.at(4).get<int>(),
+                            item_arr.size() > 5 ? item_arr.at(5).get<int>() : 1
                         });
                     }
                 }
             }
             
-            gameData.multiplier_pools = data.at("multiplier_pools").get<std::vector<std::vector<long long>>>();
+            // Pool entries are [value, weight] pairs; a bare number has weight 1.
+            for (const auto& pool_json : data.at("multiplier_pools")) {
+                MultiplierPool pool;
+                for (const auto& entry : pool_json) {
+                    if (entry.is_array()) {
+                        pool.push_back({entry.at(0).get<long long>(), entry.at(1).get<long long>()});
+                    } else {
+                        pool.push_back({entry.get<long long>(), 1});
+                    }
+                    if (pool.back().weight < 0) {
+                        throw std::runtime_error("Multiplier pool " + std::to_string(gameData.multiplier_pools.size()) + " has a negative weight.");
+                    }
+                }
+                gameData.multiplier_pools.push_back(std::move(pool));
+            }
             for (auto& [key, val] : data.at("item_to_pool_map").items()) {
                 gameData.item_to_pool_map[std::stoi(key)] = val.get<int>();
             }
 
+            readFGRules(data, fgRules);
+
         } catch (json::exception& e) {
             std::string error_msg = "JSON parsing error: ";
             error_msg += e.what();
@@ -182,20 +345,27 @@ void initializeFromJSON(const std::string& filename, double bg_value_factor, dou
                   << ", Avg (Total) = " << std::fixed << std::setprecision(4) << bg_avg_level_total
                   << ", Avg (Nonzero Value) = " << bg_avg_level_nonzero_value << std::endl;
 
-        // FG Items Stats
+        // FG Items Stats (weighted: an item of weight w counts as w raw rows)
+        long long fg_total_weight = 0;
+        for(const auto& item : gameData.fg_items) {
+            if (item.weight < 0) {
+                throw std::runtime_error("FG Item index " + std::to_string(item.index) + " has a negative weight.");
+            }
+            fg_total_weight += item.weight;
+        }
         long long fg_true_flags = 0;
         for(const auto& item : gameData.fg_items) {
-            if (item.flag) fg_true_flags++;
+            if (item.flag) fg_true_flags += item.weight;
         }
-        double fg_continue_prob = gameData.fg_items.empty() ? 0.0 : 100.0 * static_cast<double>(fg_true_flags) / gameData.fg_items.size();
-        std::cout << "FG Items: " << gameData.fg_items.size() << " entries." << std::endl;
+        double fg_continue_prob = fg_total_weight == 0 ? 0.0 : 100.0 * static_cast<double>(fg_true_flags) / fg_total_weight;
+        std::cout << "FG Items: " << gameData.fg_items.size() << " entries (total weight " << fg_total_weight << ")." << std::endl;
         std::cout << "  - Continue Items (flag=true): " << fg_true_flags << " (" << std::fixed << std::setprecision(3) << fg_continue_prob << "% chance per pick)" << std::endl;
 
         long long fg_nonzero_values = 0;
         for(const auto& item : gameData.fg_items) {
-            if (item.value != 0) fg_nonzero_values++;
+            if (item.value != 0) fg_nonzero_values += item.weight;
         }
-        double fg_nonzero_prob = gameData.fg_items.empty() ? 0.0 : 100.0 * static_cast<double>(fg_nonzero_values) / gameData.fg_items.size();
+        double fg_nonzero_prob = fg_total_weight == 0 ? 0.0 : 100.0 * static_cast<double>(fg_nonzero_values) / fg_total_weight;
         std::cout << "  - Nonzero Values: " << fg_nonzero_values << " (" << std::fixed << std::setprecision(3) << fg_nonzero_prob << "%)" << std::endl;
 
         // FG Levels Stats
@@ -212,14 +382,14 @@ void initializeFromJSON(const std::string& filename, double bg_value_factor, dou
         long long fg_nonzero_value_levels_sum = 0;
         int fg_max_level = 0;
         for(const auto& item : gameData.fg_items) {
-            fg_total_levels += item.levels;
+            fg_total_levels += static_cast<long long>(item.levels) * item.weight;
             if (item.value != 0 && item.levels != 1) {
-                fg_nonzero_value_count++;
-                fg_nonzero_value_levels_sum += item.levels;
+                fg_nonzero_value_count += item.weight;
+                fg_nonzero_value_levels_sum += static_cast<long long>(item.levels) * item.weight;
             }
-            if (item.levels > fg_max_level) fg_max_level = item.levels;
+            if (item.weight > 0 && item.levels > fg_max_level) fg_max_level = item.levels;
         }
-        double fg_avg_level_total = gameData.fg_items.empty() ? 0.0 : static_cast<double>(fg_total_levels) / gameData.fg_items.size();
+        double fg_avg_level_total = fg_total_weight == 0 ? 0.0 : static_cast<double>(fg_total_levels) / fg_total_weight;
         double fg_avg_level_nonzero_value = fg_nonzero_value_count == 0 ? 0.0 : static_cast<double>(fg_nonzero_value_levels_sum) / fg_nonzero_value_count;
         std::cout << "  - Levels: Max = " << fg_max_level
                   << ", Avg (Total) = " << std::fixed << std::setprecision(4) << fg_avg_level_total
@@ -229,146 +399,275 @@ void initializeFromJSON(const std::string& filename, double bg_value_factor, dou
         std::cout << "Multiplier Pools:" << std::endl;
         for(size_t i = 0; i < gameData.multiplier_pools.size(); ++i) {
             const auto& pool = gameData.multiplier_pools[i];
-            if(pool.empty()) {
+            const long long total_weight = poolTotalWeight(pool);
+            if(total_weight <= 0) {
                 std::cout << "  - Pool ID " << i << ": Empty" << std::endl;
                 continue;
             }
-            long long sum = std::accumulate(pool.begin(), pool.end(), 0LL);
-            double average = static_cast<double>(sum) / pool.size();
-            std::cout << "  - Pool ID " << i << ": " << pool.size() << " values, Average Multiplier = " << std::fixed << std::setprecision(4) << average << std::endl;
+            long long sum = 0;
+            for (const PoolEntry& entry : pool) sum += entry.value * entry.weight;
+            double average = static_cast<double>(sum) / total_weight;
+            std::cout << "  - Pool ID " << i << ": " << pool.size() << " values (total weight " << total_weight
+                      << "), Average Multiplier = " << std::fixed << std::setprecision(4) << average << std::endl;
         }
+        buildItemColumns();
+        std::cout << "FG Rules: " << describeFGRules(fgRules) << std::endl;
+        std::cout << "BG Outcome Classes: " << gameData.columns.bg_classes.size()
+                  << " (from " << gameData.bg_items.size() << " items)" << std::endl;
         std::cout << "--------------------------------" << std::endl;
 
         isInitialized = true;
         std::cout << "JSON data initialization complete." << std::endl;
     }
 
-    GameResult simulateGameRound(std::mt19937& rng, SimulationMode mode, double second_chance_prob) {
-        if (!isInitialized) {
-            throw std::runtime_error("FATAL: Game logic called before data was initialized.");
-        }
-        if (gameData.bg_items.empty()) {
-            return {0, 0, 0, false, 0, 1, 1, 0, {}};
-        }
+    // --- FG Processing Stage ---
+    // Plays the FG session of a round that owes initial_picks picks,
+    // accumulating into result. Does nothing when initial_picks is 0.
+    template <StatsPolicy Policy, typename PickSink, typename Rng>
+    static void playFGSession(Rng& rng, int initial_picks, GameResult& result, PickSink& sink) {
+        if (initial_picks <= 0) return;
 
-        // BG_Only Game process first
-        if (mode == SimulationMode::BG_ONLY) {
-            std::uniform_int_distribution<size_t> bg_dist(0, gameData.bg_items.size() - 1);
-            const BG_Item& chosen_bg = gameData.bg_items[bg_dist(rng)];
-            // Return only the BG score, with all FG stats as zero/false.
-            return {static_cast<double>(chosen_bg.value), 0, 0, false, 0, 1, 1, chosen_bg.levels, {}};
-        }
+        const ItemColumns& cols = gameData.columns;
+        result.fg_was_triggered = true;
+        if (cols.fg_value.empty()) return; // No FG items to process
 
+        // Sessions nobody watches pick by pick can come from the cache.
+        if constexpr (std::is_same_v<PickSink, NullPickSink>) {
+            if (fgSessionCache.draw<Policy>(rng, initial_picks, result)) return;
+        }
 
-        double bg_score = 0.0;
+        // LIFO stack of row numbers into the FG columns; a grant draws all of its
+        // rows at once. The per-thread buffer adapts to the deepest session seen
+        // so far, doubling when a grant does not fit, and is reused without
+        // allocating after that. Retriggers are only granted while at most
+        // MAX_PENDING_PICKS rows are owed, so it never holds more than that plus
+        // the largest single grant.
+        thread_local AlignedColumn<int32_t> pick_stack;
+        auto reserveRows = [](size_t rows) {
+            if (pick_stack.size() < rows) pick_stack.resize(std::max(rows, 2 * pick_stack.size()));
+        };
+        reserveRows(static_cast<size_t>(initial_picks));
+        size_t pending_picks = 0;
+        for (int i = 0; i < initial_picks; ++i) {
+            pick_stack[pending_picks++] = cols.fg_sampler.sample(rng);
+        }
         double fg_score = 0.0;
         long long fg_items_processed = 0;
         long long fg_nonzero_picks = 0;
-        bool fg_was_triggered = false;
-        bool proceed_to_fg = false;
-        int bg_levels = 0;
-        std::vector<int> fg_levels;
-
-        if (mode == SimulationMode::FG_ONLY) {
-            // In FG_ONLY mode, we skip BG logic entirely.
-            // BG score is 0 and we always proceed.
-            proceed_to_fg = true;
-        } else { // FULL_GAME mode
-            if (gameData.bg_items.empty()) return {0, 0, 0, false, 0, 1, 1, 0, {}};
-
-            std::uniform_int_distribution<size_t> bg_dist(0, gameData.bg_items.size() - 1);
-            const BG_Item& chosen_bg = gameData.bg_items[bg_dist(rng)];
-            bg_score = chosen_bg.value;
-            bg_levels = chosen_bg.levels;
-
-            if (chosen_bg.flag) {
-                proceed_to_fg = true;
+        long long max_fg_multiplier = 1;
+        long long fg_dropped_picks = 0;
+        FGLevelSummary fg_levels;
+
+        while (pending_picks > 0) {
+            fg_items_processed++; // Increment counter for each item processed
+            const int32_t fg = pick_stack[--pending_picks];
+            if constexpr (tracksLevelStats<Policy>) {
+                fg_levels.add(cols.fg_levels[fg]);
+            }
+
+            // Rows without a pool table pay their value as is and report the
+            // level multiplier; the rest pay value times one draw from the
+            // load-time distribution of the sum of fg_count pool draws.
+            long long value_multiplier = 1;
+            long long total_multiplier;
+            const int32_t sum_table = cols.fg_sum_table[fg];
+            if (sum_table >= 0) {
+                const MultiplierSumTable& table = cols.multiplier_sums[sum_table];
+                value_multiplier = total_multiplier = table.sums[table.sampler.sample(rng)];
             } else {
-                // --- Second Chance Logic ---
-                if (second_chance_prob > 0) {
-                    std::uniform_real_distribution<double> chance_dist(0.0, 1.0);
-                    if (chance_dist(rng) < second_chance_prob) {
-                        proceed_to_fg = true;
-                    }
+                total_multiplier = cols.fg_multiplier[fg];
+            }
+
+            double item_contribution = cols.fg_value[fg] * value_multiplier;
+            sink.fgPick(fg, cols.fg_levels[fg], total_multiplier, cols.fg_retrigger_picks[fg], item_contribution);
+            fg_score += item_contribution;
+
+            if constexpr (tracksRunStats<Policy>) {
+                if (total_multiplier >= max_fg_multiplier) max_fg_multiplier = total_multiplier;
+
+                // Track nonzero picks
+                if (item_contribution != 0.0) {
+                    fg_nonzero_picks++;
                 }
             }
+
+            const int32_t retrigger_picks = cols.fg_retrigger_picks[fg];
+            if (retrigger_picks > 0) {
+                if (pending_picks > MAX_PENDING_PICKS) {
+                    fg_dropped_picks += retrigger_picks; // Runaway retrigger cap
+                    continue;
+                }
+                reserveRows(pending_picks + retrigger_picks);
+                for (int32_t i = 0; i < retrigger_picks; ++i) {
+                    pick_stack[pending_picks++] = cols.fg_sampler.sample(rng);
+                }
+            }
+        }
+
+        result.fg_score = fg_score;
+        result.fg_run_length = fg_items_processed;
+        result.fg_nonzero_picks = fg_nonzero_picks;
+        result.max_fg_multiplier = max_fg_multiplier;
+        result.fg_levels = fg_levels;
+        result.fg_dropped_picks = fg_dropped_picks;
+    }
+
+    // Core round logic shared by the single-round and batched entry points.
+    // Mode and Policy are compile-time, so each combination gets its own loop
+    // and skips the bookkeeping it does not report.
+    // Callers are responsible for the isInitialized check.
+    template <SimulationMode Mode, StatsPolicy Policy, typename PickSink, typename Rng>
+    static GameResult playRound(Rng& rng, double second_chance_prob, PickSink& sink) {
+        const ItemColumns& cols = gameData.columns;
+        GameResult result = {0, 0, 0, false, 0, 1, 1, 0, {}};
+        if (cols.bg_classes.empty()) {
+            return result;
+        }
+
+        int initial_picks = 0;
+        if constexpr (Mode == SimulationMode::FG_ONLY) {
+            // In FG_ONLY mode, we skip BG logic entirely. BG score is 0 and the
+            // initial picks are drawn per the FG_ONLY start rule.
+            initial_picks = fgOnlyStart.draw(rng, second_chance_prob);
+        } else { // BG_ONLY and FULL_GAME modes both pick a BG item first
+            const int32_t bg_class = cols.bg_sampler.sample(rng);
+            const BGOutcomeClass& bg = cols.bg_classes[bg_class];
+            applyBGClass<Policy>(bg, result);
+            sink.bgPick(bg_class, result.bg_score);
+
+            // BG_Only returns only the BG score, with all FG stats as zero/false.
+            if constexpr (Mode == SimulationMode::BG_ONLY) {
+                return result;
+            }
+
+            // --- Second Chance Logic ---
+            initial_picks = applySecondChance(rng, bg.trigger_picks, second_chance_prob, fgRules.second_chance_picks);
         }
 
-        if (!proceed_to_fg) {
-            return {bg_score, 0, 0, false, 0, 1, 1, bg_levels, {}};
+        playFGSession<Policy>(rng, initial_picks, result, sink);
+        return result;
+    }
+
+    // Runtime-mode entry to playRound, used by the single-round API.
+    template <StatsPolicy Policy, typename PickSink, typename Rng>
+    static GameResult playRound(Rng& rng, SimulationMode mode, double second_chance_prob, PickSink& sink) {
+        switch (mode) {
+            case SimulationMode::BG_ONLY: return playRound<SimulationMode::BG_ONLY, Policy>(rng, second_chance_prob, sink);
+            case SimulationMode::FG_ONLY: return playRound<SimulationMode::FG_ONLY, Policy>(rng, second_chance_prob, sink);
+            case SimulationMode::FULL_GAME: break;
         }
+        return playRound<SimulationMode::FULL_GAME, Policy>(rng, second_chance_prob, sink);
+    }
 
-        // --- FG Processing Stage ---
-        long long max_fg_multiplier = 1;
-        fg_was_triggered = true;
-        if(gameData.fg_items.empty()) return {bg_score, 0, 0, true, 0, 1, 1, bg_levels, {}};
+    // The game's kernel policy for the shared block loops in RoundKernels.h.
+    struct Kernel {
+        using Result = GameResult;
+        static const ItemColumns& columns() { return gameData.columns; }
+        static int secondChancePicks() { return fgRules.second_chance_picks; }
+        static Result emptyResult() { return {0, 0, 0, false, 0, 1, 1, 0, {}}; }
 
-        std::vector<FG_Item> fg_processing_queue;
-        fg_processing_queue.reserve(100);
-        fg_levels.reserve(100);
-        std::uniform_int_distribution<size_t> fg_dist(0, gameData.fg_items.size() - 1);
+        template <SimulationMode Mode, StatsPolicy Policy, typename PickSink, typename Rng>
+        static Result playRound(Rng& rng, double second_chance_prob, PickSink& sink) {
+            return DeepDive::playRound<Mode, Policy>(rng, second_chance_prob, sink);
+        }
 
-        for (int i = 0; i < 10; ++i) {
-            fg_processing_queue.push_back(gameData.fg_items[fg_dist(rng)]);
+        template <StatsPolicy Policy, typename PickSink, typename Rng>
+        static void playFGSession(Rng& rng, int initial_picks, Result& result, PickSink& sink) {
+            DeepDive::playFGSession<Policy>(rng, initial_picks, result, sink);
         }
+    };
 
-        // Added a flag to ensure the warning message only prints once per simulation run.
-        static std::atomic<bool> cap_warning_logged_this_run = false;
-        cap_warning_logged_this_run = false; // Reset for each new game round.
+    template <typename PickSink, typename Rng>
+    GameResult simulateGameRound(Rng& rng, SimulationMode mode, double second_chance_prob, PickSink& sink) {
+        if (!isInitialized) {
+            throw std::runtime_error("FATAL: Game logic called before data was initialized.");
+        }
+        return playRound<StatsPolicy::FULL>(rng, mode, second_chance_prob, sink);
+    }
 
+    template <typename Rng>
+    GameResult simulateGameRound(Rng& rng, SimulationMode mode, double second_chance_prob) {
+        NullPickSink sink;
+        return simulateGameRound(rng, mode, second_chance_prob, sink);
+    }
 
-        while (!fg_processing_queue.empty()) {
-            fg_items_processed++; // Increment counter for each item processed
-            FG_Item current_fg = fg_processing_queue.back();
-            fg_processing_queue.pop_back();
-            fg_levels.push_back(current_fg.levels);
+    template <SimulationMode Mode, StatsPolicy Policy, typename Rng>
+    void simulateGameRounds(Rng& rng, double second_chance_prob, size_t n, GameResultBlock& out) {
+        if (!isInitialized) {
+            throw std::runtime_error("FATAL: Game logic called before data was initialized.");
+        }
+        fillRounds<Kernel, Mode, Policy>(rng, second_chance_prob, n, out);
+    }
 
-            long long total_multiplier;
-            if (current_fg.count == 0) {
-                total_multiplier = 1;
-            } else {
-                total_multiplier = 0;
-                auto map_it = gameData.item_to_pool_map.find(current_fg.index);
-                if (map_it != gameData.item_to_pool_map.end()) {
-                    int pool_id = map_it->second;
-                    if (pool_id >= 0 && pool_id < gameData.multiplier_pools.size()) {
-                        const auto& pool = gameData.multiplier_pools[pool_id];
-                        if (!pool.empty()) {
-                            std::uniform_int_distribution<size_t> multi_dist(0, pool.size() - 1);
-                            for (int i = 0; i < current_fg.count; ++i) {
-                                total_multiplier += pool[multi_dist(rng)];
-                            }
-                        }
-                    }
-                }
-            }
+    template <StatsPolicy Policy, typename Rng>
+    void simulateGameRoundsSkippingInert(Rng& rng, double second_chance_prob, size_t n, GameResultBlock& out) {
+        if (!isInitialized) {
+            throw std::runtime_error("FATAL: Game logic called before data was initialized.");
+        }
+        fillRoundsSkippingInert<Kernel, Policy>(rng, second_chance_prob, n, out);
+    }
 
-            double item_contribution = current_fg.value * total_multiplier;
-            if (total_multiplier >= max_fg_multiplier) max_fg_multiplier = total_multiplier;
-            fg_score += item_contribution;
+    ItemContributions makeItemContributions() {
+        const ItemColumns& cols = gameData.columns;
+        ItemContributions counters;
+        counters.reset(cols.bg_classes.size(), cols.fg_value.size());
+        return counters;
+    }
 
-            // Track nonzero picks
-            if (item_contribution != 0.0) {
-                fg_nonzero_picks++;
-            }
+    template <SimulationMode Mode, StatsPolicy Policy, typename Rng>
+    void simulateGameRoundsTracked(Rng& rng, double second_chance_prob, size_t n, GameResultBlock& out,
+                                   ItemContributions& counters) {
+        if (!isInitialized) {
+            throw std::runtime_error("FATAL: Game logic called before data was initialized.");
+        }
+        fillRoundsTracked<Kernel, Mode, Policy>(rng, second_chance_prob, n, out, counters);
+    }
 
-            if (current_fg.flag) {
-                if (fg_processing_queue.size() > MAX_QUEUE_SIZE) {
-                    // Added a one-time warning message when the queue cap is hit.
-                    bool already_logged = cap_warning_logged_this_run.exchange(true);
-                    if (!already_logged) {
-                        #pragma omp critical
-                        {
-                           std::cout << "\n[Warning] FG processing queue limit of " << MAX_QUEUE_SIZE << " reached. Capping round to prevent excess memory use.\n";
-                        }
-                    }
-                    continue; // Memory protection cap
-                }
-                for (int i = 0; i < 10; ++i) {
-                    fg_processing_queue.push_back(gameData.fg_items[fg_dist(rng)]);
-                }
-            }
+    double fgEntryProbability(double second_chance_prob) {
+        if (!isInitialized) {
+            throw std::runtime_error("FATAL: Game logic called before data was initialized.");
+        }
+        return fgOnlyStart.entryProbability(second_chance_prob);
+    }
+
+    bool fgOnlyStartsAtBGEntry() {
+        return fgOnlyStart.fromBG();
+    }
+
+    std::string describeBGClass(int32_t bg_class) {
+        return Game::describeBGClass(gameData.columns, gameData.bg_items, bg_class);
+    }
+
+    std::string describeFGRow(int32_t fg_row) {
+        const FG_Item& item = gameData.fg_items.at(fg_row);
+        std::ostringstream out;
+        out << "index " << item.index << ", value " << item.value << ", flag " << item.flag
+            << ", count " << item.count << ", levels " << item.levels << ", weight " << item.weight;
+        if (item.count > 0) out << ", pool " << gameData.columns.fg_pool[fg_row];
+        return out.str();
+    }
+
+    template <typename Rng>
+    void buildFGSessionCache(Rng& rng, size_t sessions_per_trigger) {
+        if (!isInitialized) {
+            throw std::runtime_error("FATAL: Game logic called before data was initialized.");
         }
-        return {bg_score, fg_score, fg_items_processed, true, fg_nonzero_picks, 1, max_fg_multiplier, bg_levels, fg_levels};
+        Game::buildFGSessionCache<Kernel>(rng, fgOnlyStart.pickCounts(), sessions_per_trigger, fgSessionCache);
+    }
+
+    size_t fgSessionCacheSize() {
+        return fgSessionCache.sessions;
     }
+
+    template <typename Rng>
+    void simulateGameRounds(Rng& rng, SimulationMode mode, double second_chance_prob, size_t n, GameResultBlock& out) {
+        switch (mode) {
+            case SimulationMode::BG_ONLY: simulateGameRounds<SimulationMode::BG_ONLY, StatsPolicy::FULL>(rng, second_chance_prob, n, out); return;
+            case SimulationMode::FG_ONLY: simulateGameRounds<SimulationMode::FG_ONLY, StatsPolicy::FULL>(rng, second_chance_prob, n, out); return;
+            case SimulationMode::FULL_GAME: simulateGameRounds<SimulationMode::FULL_GAME, StatsPolicy::FULL>(rng, second_chance_prob, n, out); return;
+        }
+    }
+
+    // Every kernel is instantiated once per generator registered in Rng.h.
+    GAME_REGISTERED_RNGS(GAME_INSTANTIATE_KERNELS)
 }
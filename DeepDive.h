@@ -1,13 +1,17 @@
 #ifndef DEEPDIVE_H
 #define DEEPDIVE_H
 
+#include <map>
 #include <vector>
 #include <string>
-#include <random>
 #include <unordered_map>
-#include <atomic> // <-- ADDED: For thread-safe initialization flag
+#include <cstdint>
+#include "AlignedColumn.h"
+#include "AliasTable.h"
+#include "GameTypes.h"
+#include "Rng.h"
 
-namespace Game {
+namespace Game::DeepDive {
 
     // Represents an item in the "BG" vector: <index, values, bool>
     struct BG_Item {
@@ -17,24 +21,80 @@ namespace Game {
         int levels;
     };
 
-    // Represents an item in the "FG" vector: <index, values, bool, counts>
+    // Represents an item in the "FG" vector: <index, values, bool, counts, levels, weight>
     struct FG_Item {
         int index;
         int value;
         bool flag;
         int count;
         int levels;
+        int weight = 1;  // Relative draw frequency; optional in the JSON, defaults to 1
     };
 
     // Represents a mapping from an item's index to the ID of a multiplier pool.
     using MultiplierMap = std::unordered_map<int, int>;
 
+    // One entry of a multiplier pool: a multiplier and its relative weight.
+    struct PoolEntry {
+        long long value;
+        long long weight;
+    };
+    using MultiplierPool = std::vector<PoolEntry>;
+
+    // Distribution of the sum of `count` independent draws from one multiplier
+    // pool, convolved at load time so an FG pick needs a single draw.
+    struct MultiplierSumTable {
+        int pool_id;
+        int count;
+        AlignedColumn<long long> sums;  // Distinct totals, ascending
+        AliasTable sampler;             // Indices into sums, weighted by probability
+    };
+
+    // One distinct BG outcome: every BG item with the same (value, trigger
+    // picks, levels) behaves identically, so the kernel samples these instead of rows.
+    // Every field is an int32 so the record can be gathered field by field.
+    struct BGOutcomeClass {
+        int32_t value;
+        int32_t trigger_picks; // FG picks granted, resolved from the flag by the trigger rule
+        int32_t levels;
+        int32_t multiplier;    // From the BG level map; 1 unless the config maps levels
+    };
+
+    // Kernel-side copy of the item tables, built once after loading.
+    // BG items are collapsed into outcome classes weighted by how many rows
+    // share them and drawn through alias tables; FG items are stored column-wise
+    // (SoA), row i of each column being item i of the table.
+    // Pick counts, multipliers and pool tables are resolved per item from the FG rules.
+    struct ItemColumns {
+        AlignedColumn<BGOutcomeClass> bg_classes;
+        AliasTable bg_sampler;            // Over all classes, weighted by row count
+        std::vector<int32_t> bg_row_class; // Class of each BG row, for reports
+
+        // The inert class (value 0, flag false, level 1) pays nothing and reports
+        // only defaults unless a second chance sends it into FG.
+        int32_t bg_inert_class = -1;      // Index into bg_classes, or -1 if absent
+        double bg_inert_share = 0.0;      // Fraction of BG rows in the inert class
+        AliasTable bg_eventful_sampler;   // Over every other class, returns bg_classes indices
+
+        AlignedColumn<int32_t> fg_value;
+        AlignedColumn<int32_t> fg_retrigger_picks; // Picks owed after the row, resolved from the flag
+        AlignedColumn<int32_t> fg_count;
+        AlignedColumn<int32_t> fg_levels;
+        AlignedColumn<int32_t> fg_multiplier;      // From the FG level map; reported for rows without a pool table
+        AlignedColumn<int32_t> fg_pool;    // Multiplier pool resolved from item_to_pool_map; -1 when count is 0 or pools are ignored
+        AlignedColumn<int32_t> fg_sum_table; // Index into multiplier_sums; -1 when fg_pool is -1
+        AliasTable fg_sampler;             // Over FG rows, weighted by FG_Item::weight
+
+        std::vector<MultiplierSumTable> multiplier_sums;  // One per (pool, count) pair in use
+    };
+
     // --- Internal Game Data Storage ---
     struct DeepDiveData {
         std::vector<BG_Item> bg_items;
         std::vector<FG_Item> fg_items;
-        std::vector<std::vector<long long>> multiplier_pools;
+        std::vector<MultiplierPool> multiplier_pools;
         MultiplierMap item_to_pool_map;
+        ItemColumns columns;  // Derived from bg_items/fg_items at load time
     };
 
 
@@ -47,19 +107,14 @@ namespace Game {
         long long fg_run_length;         // Total number of FG picks in this session
         bool fg_was_triggered;
         long long fg_nonzero_picks;      // Count of FG picks with nonzero value in this session
-        long long max_bg_multiplier = 1;  // In this case, defaults to 1 since bg does not have multiplier
+        long long max_bg_multiplier = 1;  // From the BG level map; 1 unless the config maps levels
         long long max_fg_multiplier;    // The max of total multiplier observed in simulation 
         int bg_levels; // The level count of selected bg_item 
-        std::vector<int> fg_levels; // The level counts of all fg_items selected. 
+        FGLevelSummary fg_levels; // Level summary of all fg_items selected
+        long long fg_dropped_picks = 0; // FG picks discarded by the pending-pick cap in this session
     };
 
 
-    enum class SimulationMode {
-        FULL_GAME,
-        FG_ONLY,
-        BG_ONLY
-    };
-
     // --- Game Module Interface ---
     void initializeWithSampleData();
     /**
@@ -74,12 +129,159 @@ namespace Game {
         double fg_value_factor = 1.0
     );
 
-    GameResult simulateGameRound(std::mt19937& rng, SimulationMode mode, double second_chance_prob);
+    template <typename Rng>
+    GameResult simulateGameRound(Rng& rng, SimulationMode mode, double second_chance_prob);
+
+    /**
+     * @brief Simulates one round and reports every pick to a caller-supplied sink.
+     * @param sink Called as sink.bgPick(bg_class, value) for the BG draw, if any,
+     *             then as sink.fgPick(fg_row, level, multiplier, retrigger_picks, value)
+     *             once per FG pick, in pick order.
+     *             bg_class indexes ItemColumns::bg_classes; fg_row indexes the FG table.
+     * @note Defined in DeepDive.cpp; each sink type in use is explicitly instantiated there.
+     */
+    template <typename PickSink, typename Rng>
+    GameResult simulateGameRound(Rng& rng, SimulationMode mode, double second_chance_prob, PickSink& sink);
+
+    /**
+     * @brief Simulates n consecutive rounds into a caller-owned result block.
+     * @param n Number of rounds to simulate; the block is resized to n rows.
+     * @param out Destination block, reused across calls to avoid reallocation.
+     */
+    template <typename Rng>
+    void simulateGameRounds(Rng& rng, SimulationMode mode, double second_chance_prob, size_t n, GameResultBlock& out);
+
+    /**
+     * @brief Compile-time specialized form of simulateGameRounds.
+     * Each (Mode, Policy) pair is explicitly instantiated in the game .cpp for
+     * every generator registered in Rng.h, and columns outside the policy are
+     * left untouched.
+     */
+    template <SimulationMode Mode, StatsPolicy Policy, typename Rng>
+    void simulateGameRounds(Rng& rng, double second_chance_prob, size_t n, GameResultBlock& out);
+
+    /**
+     * @brief FULL_GAME batch with geometric skip-ahead over inert BG rounds.
+     * The number of inert rounds before each eventful one is drawn from a
+     * geometric distribution, so only eventful rounds are simulated and stored.
+     * On return out.size is the number of stored rows and out.inert_rounds the
+     * number of skipped rounds; together they cover exactly n rounds. Every
+     * skipped round has bg_score 0, fg_score 0, bg_levels 1 and no FG.
+     */
+    template <StatsPolicy Policy, typename Rng>
+    void simulateGameRoundsSkippingInert(Rng& rng, double second_chance_prob, size_t n, GameResultBlock& out);
+
+    // Zeroed counters sized for the loaded BG classes and FG rows.
+    ItemContributions makeItemContributions();
+
+    /**
+     * @brief simulateGameRounds that also counts every pick into per-item counters.
+     * Every round is played in full, so neither the BG_ONLY batch path nor the
+     * FG session cache is used; results match an untracked run statistically.
+     */
+    template <SimulationMode Mode, StatsPolicy Policy, typename Rng>
+    void simulateGameRoundsTracked(Rng& rng, double second_chance_prob, size_t n, GameResultBlock& out,
+                                   ItemContributions& counters);
+
+    /**
+     * @brief Probability that a FULL_GAME round plays an FG session: it lands
+     * on a triggering BG row, or on any other row and wins the second chance.
+     */
+    double fgEntryProbability(double second_chance_prob);
+
+    /**
+     * @brief True when FG_ONLY rounds start the way FULL_GAME rounds enter FG
+     * (fg_only_start "bg_entry", the default). An FG_ONLY run then estimates
+     * E[FG | entered], and E[total] = E[BG] + fgEntryProbability(s) * E[FG | entered]
+     * combines it exactly with a BG_ONLY run.
+     */
+    bool fgOnlyStartsAtBGEntry();
+
+    /**
+     * @brief Distribution of the total of count independent weighted draws
+     * from pool, by repeated convolution: total -> probability, ascending.
+     * Entries of weight 0 are never drawn. Each MultiplierSumTable is built
+     * from it at load time.
+     */
+    std::map<long long, double> multiplierSumDistribution(const MultiplierPool& pool, int count);
+
+    // Short descriptions of a BG outcome class and an FG row, for reports.
+    std::string describeBGClass(int32_t bg_class);
+    std::string describeFGRow(int32_t fg_row);
+
+    /**
+     * @brief Pre-simulates complete FG sessions for the "fast BG sweep" engine.
+     * An FG session depends only on its initial pick count, so for every count
+     * a round can start with (the BG trigger grant, the second chance grant and
+     * the FG_ONLY start) a reservoir of sessions_per_trigger finished sessions
+     * is stored. While the cache is held, every FG session played without a pick
+     * sink is drawn uniformly from the reservoir for its pick count instead of
+     * replaying the pick loop. Results are then conditional on the reservoir, so
+     * it should be large next to the number of FG sessions a run expects.
+     * Reloading the game data discards the cache.
+     * @param sessions_per_trigger Sessions stored per pick count; 0 discards the cache.
+     */
+    template <typename Rng>
+    void buildFGSessionCache(Rng& rng, size_t sessions_per_trigger);
+
+    // Sessions stored by the current cache, or 0 if none is held.
+    size_t fgSessionCacheSize();
 
     // HIGHLIGHT: Added a public "getter" function to safely access the game data.
     const DeepDiveData& getGameData();
 
 
+} // namespace Game::DeepDive
+
+namespace Game {
+
+    // Static policy that MonteCarloSimulator is instantiated with for this game.
+    // Every member forwards to Game::DeepDive, so the simulator calls the game's
+    // kernels directly; GameModule.h registers it for runtime selection.
+    struct DeepDiveModule {
+        static constexpr const char* name = "DeepDive";
+        static constexpr const char* default_config = "SS02_Config_Table01_v1.json";
+        // The FG cap drops a retrigger's picks and the session keeps going.
+        static constexpr bool fg_cap_ends_session = false;
+
+        static void initializeFromJSON(const std::string& filename, double bg_value_factor, double fg_value_factor) {
+            DeepDive::initializeFromJSON(filename, bg_value_factor, fg_value_factor);
+        }
+
+        template <SimulationMode Mode, StatsPolicy Policy, typename Rng>
+        static void simulateGameRounds(Rng& rng, double second_chance_prob, size_t n, GameResultBlock& out) {
+            DeepDive::simulateGameRounds<Mode, Policy>(rng, second_chance_prob, n, out);
+        }
+
+        template <StatsPolicy Policy, typename Rng>
+        static void simulateGameRoundsSkippingInert(Rng& rng, double second_chance_prob, size_t n, GameResultBlock& out) {
+            DeepDive::simulateGameRoundsSkippingInert<Policy>(rng, second_chance_prob, n, out);
+        }
+
+        template <typename PickSink, typename Rng>
+        static DeepDive::GameResult simulateGameRound(Rng& rng, SimulationMode mode, double second_chance_prob, PickSink& sink) {
+            return DeepDive::simulateGameRound(rng, mode, second_chance_prob, sink);
+        }
+
+        template <SimulationMode Mode, StatsPolicy Policy, typename Rng>
+        static void simulateGameRoundsTracked(Rng& rng, double second_chance_prob, size_t n, GameResultBlock& out,
+                                              ItemContributions& counters) {
+            DeepDive::simulateGameRoundsTracked<Mode, Policy>(rng, second_chance_prob, n, out, counters);
+        }
+
+        static ItemContributions makeItemContributions() { return DeepDive::makeItemContributions(); }
+        static double fgEntryProbability(double second_chance_prob) { return DeepDive::fgEntryProbability(second_chance_prob); }
+        static bool fgOnlyStartsAtBGEntry() { return DeepDive::fgOnlyStartsAtBGEntry(); }
+        static std::string describeBGClass(int32_t bg_class) { return DeepDive::describeBGClass(bg_class); }
+        static std::string describeFGRow(int32_t fg_row) { return DeepDive::describeFGRow(fg_row); }
+
+        template <typename Rng>
+        static void buildFGSessionCache(Rng& rng, size_t sessions_per_trigger) {
+            DeepDive::buildFGSessionCache(rng, sessions_per_trigger);
+        }
+        static size_t fgSessionCacheSize() { return DeepDive::fgSessionCacheSize(); }
+    };
+
 } // namespace Game
 
 #endif // DEEPDIVE_H
@@ -0,0 +1,278 @@
+#ifndef FG_RULES_H
+#define FG_RULES_H
+
+#include <cstdint>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "AliasTable.h"
+#include "json.hpp"
+
+namespace Game {
+
+    // How many FG picks a trigger or retrigger grants. Every item carries a
+    // trigger count (SS03's trigger_num/retrigger_num, DeepDive's flag as 0/1).
+    enum class PickRule {
+        ITEM_COUNT,  // The item's count itself
+        FIXED        // A fixed number of picks whenever the count is nonzero
+    };
+
+    // How an FG pick's payout relates to its multiplier.
+    enum class MultiplierRule {
+        IN_VALUE,    // The value already includes it; the level map gives it for statistics
+        POOL_SUM     // Value times the sum of `count` draws from the item's multiplier pool
+    };
+
+    // Where the initial picks of an FG_ONLY round come from.
+    enum class FGOnlyStart {
+        BG_ENTRY,    // Drawn like a FULL_GAME round that enters FG: a BG trigger grant or a second chance
+        EXPLICIT     // Drawn from FGRules::fg_only_picks
+    };
+
+    struct PickWeight {
+        int picks;
+        double weight;
+    };
+
+    // Multiplier per level: entry i is level i + 1. Levels below 1 use the
+    // first entry, levels past the end use the last.
+    struct LevelMultipliers {
+        std::vector<int32_t> by_level;
+
+        int32_t at(int level) const {
+            if (level <= 1) return by_level.front();
+            const size_t i = static_cast<size_t>(level) - 1;
+            return i < by_level.size() ? by_level[i] : by_level.back();
+        }
+    };
+
+    // Configurable FG rules for SS03 and DeepDive, read from the optional
+    // "fg_rules" object of their configs. Each of the two games supplies
+    // defaults that reproduce its original rules; its loader resolves them
+    // into the item columns, so the kernels read per-row pick counts and
+    // multipliers and never branch on a rule.
+    //
+    // This is not a generic rule engine. The rules only re-parameterise the
+    // two existing modules: their item table layouts (SS03's
+    // trigger_num/retrigger_num counts, DeepDive's flag, count and multiplier
+    // pools), their kernels and the module registration are still C++, so any
+    // other game needs its own module (see BUILD.md, "Adding a New Game Module").
+    struct FGRules {
+        PickRule trigger = PickRule::ITEM_COUNT;
+        int trigger_picks = 10;              // Used by PickRule::FIXED
+        PickRule retrigger = PickRule::ITEM_COUNT;
+        int retrigger_picks = 10;            // Used by PickRule::FIXED
+        int second_chance_picks = 10;        // Picks granted by a successful second chance
+        FGOnlyStart fg_only_start = FGOnlyStart::BG_ENTRY;
+        std::vector<PickWeight> fg_only_picks; // Used by FGOnlyStart::EXPLICIT
+        MultiplierRule multiplier = MultiplierRule::IN_VALUE;
+        LevelMultipliers bg_level_multipliers{{1}};
+        LevelMultipliers fg_level_multipliers{{1}};
+
+        int triggerPicks(int count) const { return resolvePicks(trigger, trigger_picks, count); }
+        int retriggerPicks(int count) const { return resolvePicks(retrigger, retrigger_picks, count); }
+
+    private:
+        static int resolvePicks(PickRule rule, int fixed_picks, int count) {
+            if (count <= 0) return 0;
+            return rule == PickRule::FIXED ? fixed_picks : count;
+        }
+    };
+
+    namespace detail {
+
+        inline PickRule readPickRule(const nlohmann::json& j, const char* key, int& fixed_picks, PickRule fallback) {
+            if (!j.contains(key)) return fallback;
+            const nlohmann::json& rule = j.at(key);
+            const std::string name = rule.at("rule").get<std::string>();
+            if (name == "item_count") return PickRule::ITEM_COUNT;
+            if (name == "fixed") {
+                fixed_picks = rule.at("picks").get<int>();
+                if (fixed_picks < 1) {
+                    throw std::runtime_error(std::string("fg_rules.") + key + ".picks must be at least 1.");
+                }
+                return PickRule::FIXED;
+            }
+            throw std::runtime_error(std::string("fg_rules.") + key + ".rule must be \"item_count\" or \"fixed\", got \"" + name + "\".");
+        }
+
+        inline void readLevelMultipliers(const nlohmann::json& j, const char* key, LevelMultipliers& out) {
+            if (!j.contains(key)) return;
+            std::vector<int32_t> by_level = j.at(key).get<std::vector<int32_t>>();
+            if (by_level.empty()) {
+                throw std::runtime_error(std::string("fg_rules.") + key + " must list at least one multiplier.");
+            }
+            out.by_level = std::move(by_level);
+        }
+
+        inline void readFGOnlyStart(const nlohmann::json& j, FGRules& rules) {
+            if (!j.contains("fg_only_start")) return;
+            const nlohmann::json& start = j.at("fg_only_start");
+            if (start.is_string()) {
+                const std::string name = start.get<std::string>();
+                if (name != "bg_entry") {
+                    throw std::runtime_error("fg_rules.fg_only_start must be \"bg_entry\", a pick count or [[picks, weight], ...], got \"" + name + "\".");
+                }
+                rules.fg_only_start = FGOnlyStart::BG_ENTRY;
+                rules.fg_only_picks.clear();
+                return;
+            }
+            std::vector<PickWeight> picks;
+            if (start.is_number()) {
+                picks.push_back({start.get<int>(), 1.0});
+            } else {
+                for (const auto& entry : start) picks.push_back({entry.at(0).get<int>(), entry.at(1).get<double>()});
+            }
+            double total_weight = 0.0;
+            for (const PickWeight& p : picks) {
+                if (p.picks < 1) throw std::runtime_error("fg_rules.fg_only_start pick counts must be at least 1.");
+                if (!(p.weight >= 0.0)) throw std::runtime_error("fg_rules.fg_only_start weights must be non-negative.");
+                total_weight += p.weight;
+            }
+            if (!(total_weight > 0.0)) throw std::runtime_error("fg_rules.fg_only_start needs a positive total weight.");
+            rules.fg_only_start = FGOnlyStart::EXPLICIT;
+            rules.fg_only_picks = std::move(picks);
+        }
+
+        inline int readPickCount(const nlohmann::json& j, const char* key, int fallback) {
+            if (!j.contains(key)) return fallback;
+            const int picks = j.at(key).get<int>();
+            if (picks < 1) throw std::runtime_error(std::string("fg_rules.") + key + " must be at least 1.");
+            return picks;
+        }
+
+    } // namespace detail
+
+    /**
+     * @brief Overrides rules with the fields present in config["fg_rules"].
+     * Missing fields keep the value passed in, so an absent block leaves the
+     * game's defaults untouched. Throws std::runtime_error on invalid rules.
+     *
+     * "fg_rules": {
+     *   "trigger":   {"rule": "item_count"} or {"rule": "fixed", "picks": 10},
+     *   "retrigger": {"rule": "item_count"} or {"rule": "fixed", "picks": 10},
+     *   "second_chance_picks": 10,
+     *   "fg_only_start": "bg_entry" or 10 or [[10, 3], [15, 1]],
+     *   "multiplier": "in_value" or "pool_sum",
+     *   "bg_level_multipliers": [1, 2, 3, 5],
+     *   "fg_level_multipliers": [2, 4, 6, 10]
+     * }
+     */
+    inline void readFGRules(const nlohmann::json& config, FGRules& rules) {
+        if (!config.contains("fg_rules")) return;
+        const nlohmann::json& j = config.at("fg_rules");
+        rules.trigger = detail::readPickRule(j, "trigger", rules.trigger_picks, rules.trigger);
+        rules.retrigger = detail::readPickRule(j, "retrigger", rules.retrigger_picks, rules.retrigger);
+        rules.second_chance_picks = detail::readPickCount(j, "second_chance_picks", rules.second_chance_picks);
+        detail::readFGOnlyStart(j, rules);
+        if (j.contains("multiplier")) {
+            const std::string name = j.at("multiplier").get<std::string>();
+            if (name == "in_value") rules.multiplier = MultiplierRule::IN_VALUE;
+            else if (name == "pool_sum") rules.multiplier = MultiplierRule::POOL_SUM;
+            else throw std::runtime_error("fg_rules.multiplier must be \"in_value\" or \"pool_sum\", got \"" + name + "\".");
+        }
+        detail::readLevelMultipliers(j, "bg_level_multipliers", rules.bg_level_multipliers);
+        detail::readLevelMultipliers(j, "fg_level_multipliers", rules.fg_level_multipliers);
+    }
+
+    // One-line summary of the rules, for the input data summary.
+    inline std::string describeFGRules(const FGRules& rules) {
+        auto picks = [](PickRule rule, int fixed_picks) {
+            return rule == PickRule::FIXED ? "fixed " + std::to_string(fixed_picks) : std::string("item count");
+        };
+        auto levels = [](const LevelMultipliers& m) {
+            std::string s;
+            for (size_t i = 0; i < m.by_level.size(); ++i) s += (i ? "," : "") + std::to_string(m.by_level[i]);
+            return "[" + s + "]";
+        };
+        std::string fg_only = "BG entry";
+        if (rules.fg_only_start == FGOnlyStart::EXPLICIT) {
+            std::ostringstream out;
+            for (size_t i = 0; i < rules.fg_only_picks.size(); ++i) {
+                out << (i ? "," : "") << rules.fg_only_picks[i].picks << ":" << rules.fg_only_picks[i].weight;
+            }
+            fg_only = "{" + out.str() + "} picks:weight";
+        }
+        return "trigger " + picks(rules.trigger, rules.trigger_picks)
+             + ", retrigger " + picks(rules.retrigger, rules.retrigger_picks)
+             + ", second chance " + std::to_string(rules.second_chance_picks)
+             + ", FG_ONLY " + fg_only
+             + ", multiplier " + (rules.multiplier == MultiplierRule::POOL_SUM ? "pool sum" : "in value")
+             + ", BG levels " + levels(rules.bg_level_multipliers)
+             + ", FG levels " + levels(rules.fg_level_multipliers);
+    }
+
+    // FG_ONLY start distribution of the loaded game, resolved at load time.
+    // Under FGOnlyStart::BG_ENTRY an FG_ONLY round starts exactly like a
+    // FULL_GAME round conditioned on entering FG, so an FG_ONLY run estimates
+    // E[FG | entered] and combines with a BG_ONLY run as
+    // E[total] = E[BG] + entryProbability(s) * E[FG | entered].
+    class FGOnlyStartTable {
+    public:
+        // bg_trigger_weight maps each BG trigger grant (picks > 0) to the
+        // number of BG rows that grant it; bg_rows is the BG row count.
+        void build(const FGRules& rules, const std::map<int, double>& bg_trigger_weight, double bg_rows) {
+            m_from_bg = rules.fg_only_start == FGOnlyStart::BG_ENTRY;
+            m_second_chance_picks = rules.second_chance_picks;
+            m_trigger_share = 0.0;
+            std::vector<double> weights;
+            std::vector<int32_t> picks;
+            if (m_from_bg) {
+                double trigger_rows = 0.0;
+                for (const auto& [p, w] : bg_trigger_weight) {
+                    picks.push_back(p);
+                    weights.push_back(w);
+                    trigger_rows += w;
+                }
+                m_trigger_share = bg_rows > 0.0 ? trigger_rows / bg_rows : 0.0;
+            } else {
+                for (const PickWeight& p : rules.fg_only_picks) {
+                    picks.push_back(p.picks);
+                    weights.push_back(p.weight);
+                }
+            }
+            m_picks.assign(picks.begin(), picks.end());
+            m_sampler.build(weights, picks);
+        }
+
+        bool fromBG() const { return m_from_bg; }
+
+        // Probability that a FULL_GAME round plays an FG session: it lands on a
+        // triggering BG row, or on any other row and wins the second chance.
+        double entryProbability(double second_chance_prob) const {
+            return m_trigger_share + (1.0 - m_trigger_share) * second_chance_prob;
+        }
+
+        // Initial picks of one FG_ONLY round; 0 if no FULL_GAME round can enter FG.
+        template <typename Rng>
+        int draw(Rng& rng, double second_chance_prob) const {
+            if (m_from_bg) {
+                const double entry = entryProbability(second_chance_prob);
+                if (!(entry > 0.0)) return 0;
+                if (m_trigger_share < entry && uniformUnit(rng) * entry >= m_trigger_share) {
+                    return m_second_chance_picks;
+                }
+            }
+            return m_sampler.sample(rng);
+        }
+
+        // Every initial pick count draw() can return, for the session cache.
+        std::vector<int> pickCounts() const {
+            std::vector<int> counts = m_picks;
+            if (m_from_bg) counts.push_back(m_second_chance_picks);
+            return counts;
+        }
+
+    private:
+        AliasTable m_sampler;           // Ids are initial pick counts
+        std::vector<int> m_picks;
+        double m_trigger_share = 0.0;   // BG_ENTRY: fraction of BG rows that trigger
+        int m_second_chance_picks = 0;
+        bool m_from_bg = false;
+    };
+
+} // namespace Game
+
+#endif // FG_RULES_H
@@ -1,15 +1,61 @@
 #ifndef GAME_MODULE_H
 #define GAME_MODULE_H
 
-// This header automatically includes the correct game module
-// based on the CMake configuration
-
-#if defined(USE_DEEPDIVE)
-    #include "DeepDive.h"
-#elif defined(USE_SS03GAME)
-    #include "SS03Game.h"
-#else
-    #error "No game module defined! Set GAME_MODULE in CMake"
-#endif
+// Registry of the game modules compiled into the simulator. Every game is
+// built into the same binary in its own namespace; a module is chosen at
+// runtime by name, and MonteCarloSimulator is instantiated once per module so
+// the hot loops call that game's kernels directly.
+//
+// To add a game: include its header here, append its module struct to
+// RegisteredGames, add it to INSTANTIATE_SIMULATORS at the end of
+// MonteCarloSimulator.cpp and add its .cpp to CMakeLists.txt.
+
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include "SS03Game.h"
+#include "DeepDive.h"
+
+namespace Game {
+
+    using RegisteredGames = std::tuple<SS03Module, DeepDiveModule>;
+
+    // Tag carrying a module type through a generic lambda.
+    template <typename Module>
+    struct ModuleTag {
+        using type = Module;
+    };
+
+    namespace detail {
+
+        template <typename Fn, typename... Modules>
+        bool dispatchGameIn(const std::string& name, Fn& fn, std::tuple<Modules...>*) {
+            return ((name == Modules::name ? (fn(ModuleTag<Modules>{}), true) : false) || ...);
+        }
+
+        template <typename... Modules>
+        std::string gameNamesIn(std::tuple<Modules...>*) {
+            std::string names;
+            ((names += (names.empty() ? "" : ", ") + std::string(Modules::name)), ...);
+            return names;
+        }
+
+    } // namespace detail
+
+    // Comma-separated names of every registered game, for usage messages.
+    inline std::string registeredGameNames() {
+        return detail::gameNamesIn(static_cast<RegisteredGames*>(nullptr));
+    }
+
+    // Invokes fn(ModuleTag<M>{}) for the registered module M called name.
+    // Throws std::runtime_error if no module has that name.
+    template <typename Fn>
+    void dispatchGame(const std::string& name, Fn&& fn) {
+        if (!detail::dispatchGameIn(name, fn, static_cast<RegisteredGames*>(nullptr))) {
+            throw std::runtime_error("Unknown game '" + name + "'. Registered games: " + registeredGameNames());
+        }
+    }
+
+} // namespace Game
 
 #endif // GAME_MODULE_H
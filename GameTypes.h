@@ -0,0 +1,229 @@
+#ifndef GAME_TYPES_H
+#define GAME_TYPES_H
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+// Types shared by every game module and by MonteCarloSimulator, and the block
+// loops that only need these types. Game-specific tables, results and kernels
+// live in each game's own namespace (Game::SS03, Game::DeepDive), so all
+// modules can be linked into one binary.
+namespace Game {
+
+    // Running summary of the levels of every FG pick in a session. It has a
+    // fixed size so building a GameResult never touches the heap.
+    struct FGLevelSummary {
+        long long total = 0;          // Sum of all FG pick levels
+        long long nonzero_sum = 0;    // Sum where level != 1
+        long long nonzero_count = 0;  // Count where level != 1
+        int max = 0;                  // Max FG pick level
+
+        void add(int level) {
+            total += level;
+            if (level != 1) {
+                nonzero_sum += level;
+                nonzero_count++;
+            }
+            if (level > max) max = level;
+        }
+    };
+
+
+    // --- Batched Result Block ---
+    // Structure-of-arrays results for a run of consecutive rounds. The block is
+    // owned by the caller and refilled by simulateGameRounds; row i of every
+    // column describes round i of the batch.
+    struct GameResultBlock {
+        enum Flags : unsigned char {
+            FG_TRIGGERED = 1 << 0
+        };
+
+        size_t size = 0;                               // Rows filled by the last batch
+        size_t inert_rounds = 0;                       // Rounds covered but not stored as rows (skip-ahead only)
+        std::vector<double> bg_score;
+        std::vector<double> fg_score;
+        std::vector<long long> fg_run_length;
+        std::vector<unsigned char> flags;              // Bitwise OR of Flags
+        std::vector<long long> fg_nonzero_picks;
+        std::vector<long long> max_bg_multiplier;
+        std::vector<long long> max_fg_multiplier;
+        std::vector<int> bg_levels;
+        std::vector<long long> fg_level_total;         // FGLevelSummary::total
+        std::vector<long long> fg_level_nonzero_sum;   // FGLevelSummary::nonzero_sum
+        std::vector<long long> fg_level_nonzero_count; // FGLevelSummary::nonzero_count
+        std::vector<int> fg_level_max;                 // FGLevelSummary::max
+        std::vector<long long> fg_dropped_picks;       // FG picks lost to the game's FG cap
+        std::vector<size_t> round_offset;              // Round of each row within the batch (skip-ahead only)
+
+        // Sets the row count to n. Columns only ever grow, so a reused block
+        // stops allocating after its first batch.
+        void resize(size_t n) {
+            if (bg_score.size() < n) {
+                bg_score.resize(n);
+                fg_score.resize(n);
+                fg_run_length.resize(n);
+                flags.resize(n);
+                fg_nonzero_picks.resize(n);
+                max_bg_multiplier.resize(n);
+                max_fg_multiplier.resize(n);
+                bg_levels.resize(n);
+                fg_level_total.resize(n);
+                fg_level_nonzero_sum.resize(n);
+                fg_level_nonzero_count.resize(n);
+                fg_level_max.resize(n);
+                fg_dropped_picks.resize(n);
+                round_offset.resize(n);
+            }
+            size = n;
+            inert_rounds = 0;
+        }
+
+        bool fg_was_triggered(size_t i) const { return (flags[i] & FG_TRIGGERED) != 0; }
+
+        // Round of row i within the batch. Rows are consecutive rounds unless
+        // inert rounds were skipped, in which case the kernel recorded each one.
+        size_t roundOffset(size_t i) const { return inert_rounds == 0 ? i : round_offset[i]; }
+    };
+
+
+    enum class SimulationMode {
+        FULL_GAME,
+        FG_ONLY,
+        BG_ONLY
+    };
+
+    // Which per-round statistics a kernel fills in. Scores are always produced;
+    // anything outside the policy keeps its default value in the result.
+    enum class StatsPolicy {
+        MINIMAL,   // BG/FG scores only
+        STANDARD,  // + FG run length, trigger flag, nonzero picks, max multipliers
+        FULL       // + BG/FG level statistics
+    };
+
+    template <StatsPolicy P>
+    inline constexpr bool tracksRunStats = P != StatsPolicy::MINIMAL;
+
+    template <StatsPolicy P>
+    inline constexpr bool tracksLevelStats = P == StatsPolicy::FULL;
+
+    // Default pick sink: ignores every pick.
+    struct NullPickSink {
+        void bgPick(int32_t /*bg_class*/, double /*value*/) const {}
+        void fgPick(int32_t /*fg_row*/, int /*level*/, long long /*multiplier*/, int /*retrigger_picks*/, double /*value*/) const {}
+    };
+
+    // Scatters one round result into row i of a block, as far as Policy requires.
+    // Works for every game's GameResult, which all share these field names.
+    template <StatsPolicy Policy, typename Result>
+    inline void storeRow(GameResultBlock& out, size_t i, const Result& r) {
+        out.bg_score[i] = r.bg_score;
+        out.fg_score[i] = r.fg_score;
+        if constexpr (tracksRunStats<Policy>) {
+            out.fg_run_length[i] = r.fg_run_length;
+            out.flags[i] = r.fg_was_triggered ? GameResultBlock::FG_TRIGGERED : 0;
+            out.fg_nonzero_picks[i] = r.fg_nonzero_picks;
+            out.max_bg_multiplier[i] = r.max_bg_multiplier;
+            out.max_fg_multiplier[i] = r.max_fg_multiplier;
+            out.fg_dropped_picks[i] = r.fg_dropped_picks;
+        }
+        if constexpr (tracksLevelStats<Policy>) {
+            out.bg_levels[i] = r.bg_levels;
+            out.fg_level_total[i] = r.fg_levels.total;
+            out.fg_level_nonzero_sum[i] = r.fg_levels.nonzero_sum;
+            out.fg_level_nonzero_count[i] = r.fg_levels.nonzero_count;
+            out.fg_level_max[i] = r.fg_levels.max;
+        }
+    }
+
+    // Block loop shared by every game: resizes out to n rows and fills row i
+    // with the i-th round of Kernel::playRound, reporting picks to sink.
+    // Kernel is the game's kernel policy (see RoundKernels.h).
+    template <typename Kernel, SimulationMode Mode, StatsPolicy Policy, typename Rng, typename PickSink>
+    void fillRounds(Rng& rng, double second_chance_prob, size_t n, GameResultBlock& out, PickSink& sink) {
+        out.resize(n);
+        for (size_t i = 0; i < n; ++i) {
+            storeRow<Policy>(out, i, Kernel::template playRound<Mode, Policy>(rng, second_chance_prob, sink));
+        }
+    }
+
+    // Exact pick counts and payout sums per table entry, for the item
+    // contribution report. BG entries are indexed by BG outcome class, since
+    // rows sharing an outcome are indistinguishable to the kernel; FG entries
+    // are indexed by FG row. Each chunk of a run fills its own copy and the
+    // copies are merged in chunk order (see ChunkMerge.h).
+    struct ItemContributions {
+        std::vector<long long> bg_picks;
+        std::vector<double> bg_payout;
+        std::vector<long long> fg_picks;
+        std::vector<double> fg_payout;
+
+        // Zeroed counters for a game with the given table sizes.
+        void reset(size_t bg_classes, size_t fg_rows) {
+            bg_picks.assign(bg_classes, 0);
+            bg_payout.assign(bg_classes, 0.0);
+            fg_picks.assign(fg_rows, 0);
+            fg_payout.assign(fg_rows, 0.0);
+        }
+
+        void merge(const ItemContributions& other) {
+            for (size_t i = 0; i < bg_picks.size() && i < other.bg_picks.size(); ++i) {
+                bg_picks[i] += other.bg_picks[i];
+                bg_payout[i] += other.bg_payout[i];
+            }
+            for (size_t i = 0; i < fg_picks.size() && i < other.fg_picks.size(); ++i) {
+                fg_picks[i] += other.fg_picks[i];
+                fg_payout[i] += other.fg_payout[i];
+            }
+        }
+    };
+
+    // Pick sink that counts every BG and FG pick into per-item counters.
+    struct ContributionSink {
+        ItemContributions& counters;
+        void bgPick(int32_t bg_class, double value) {
+            counters.bg_picks[bg_class]++;
+            counters.bg_payout[bg_class] += value;
+        }
+        void fgPick(int32_t fg_row, int /*level*/, long long /*multiplier*/, int /*retrigger_picks*/, double value) {
+            counters.fg_picks[fg_row]++;
+            counters.fg_payout[fg_row] += value;
+        }
+    };
+
+    // Tracked block loop shared by every game: fillRounds with every pick
+    // counted into counters. BG_ONLY rounds go through playRound too, since
+    // the column-pass kernel does not report picks.
+    template <typename Kernel, SimulationMode Mode, StatsPolicy Policy, typename Rng>
+    void fillRoundsTracked(Rng& rng, double second_chance_prob, size_t n, GameResultBlock& out, ItemContributions& counters) {
+        ContributionSink sink{counters};
+        fillRounds<Kernel, Mode, Policy>(rng, second_chance_prob, n, out, sink);
+    }
+
+    // Pick sink that records every pick of one round in order, for replaying
+    // and auditing single rounds.
+    struct RoundTrace {
+        struct FGPick {
+            int32_t fg_row;
+            int level;
+            long long multiplier;    // Total multiplier of the pick
+            int retrigger_picks;     // Picks the row grants after it
+            double value;            // Payout, multiplier included
+        };
+
+        int32_t bg_class = -1;       // -1 when the round had no BG draw (FG_ONLY)
+        double bg_value = 0.0;
+        std::vector<FGPick> fg_picks;
+
+        void bgPick(int32_t cls, double value) {
+            bg_class = cls;
+            bg_value = value;
+        }
+        void fgPick(int32_t fg_row, int level, long long multiplier, int retrigger_picks, double value) {
+            fg_picks.push_back({fg_row, level, multiplier, retrigger_picks, value});
+        }
+    };
+
+} // namespace Game
+
+#endif // GAME_TYPES_H
@@ -1,4 +1,9 @@
 #include "MonteCarloSimulator.h"
+#include "GameModule.h"
+#include "ChunkMerge.h"
+#include "ChunkScheduler.h"
+#include "ProgressMonitor.h"
+#include "SimdBatch.h"
 #include "Statistics.h"
 #include <iostream>
 #include <iomanip>
@@ -9,7 +14,7 @@
 #include <sstream>
 #include <limits>
 #include <stdexcept>
-#include <atomic>
+#include <type_traits>
 
 // --- OnlineStats Method Implementations ---
 
@@ -26,6 +31,14 @@ void OnlineStats::update(double value) {
     M2 += term1;
 }
 
+void OnlineStats::updateRepeated(double value, long long n) {
+    if (n <= 0) return;
+    OnlineStats run; // n identical values: mean = value, no spread
+    run.count = n;
+    run.M1 = value;
+    combine(run);
+}
+
 void OnlineStats::combine(const OnlineStats& other) {
     if (other.count == 0) return;
     if (count == 0) { *this = other; return; }
@@ -43,26 +56,260 @@ void OnlineStats::combine(const OnlineStats& other) {
     M1 = combined_M1; M2 = combined_M2; M3 = combined_M3; M4 = combined_M4; count = combined_count;
 }
 
+// Rounds simulated per simulateGameRounds call. Small enough that a
+// GameResultBlock stays cache-resident between the simulate and accumulate passes.
+static const long long kRoundsPerBlock = 1024;
+
+// Rounds per RNG stream in the fallback run(): the unit of deterministic
+// work, like a batch in the batched run(). A whole number of blocks.
+static const long long kRoundsPerChunk = 16 * kRoundsPerBlock;
+
+// Streams reserved next to the chunk streams of a run (chunk ids stay far below).
+static const uint64_t kFGCacheStream = ~0ULL;
+static const uint64_t kBootstrapStreamBase = 1ULL << 62;
+
+// Invokes fn(mode_tag, policy_tag) with std::integral_constant tags for the
+// runtime mode and policy, so callers can instantiate a specialized runner.
+template <typename Fn>
+static void dispatchKernel(Game::SimulationMode mode, Game::StatsPolicy policy, Fn&& fn) {
+    auto with_policy = [&](auto mode_tag) {
+        switch (policy) {
+            case Game::StatsPolicy::MINIMAL:
+                fn(mode_tag, std::integral_constant<Game::StatsPolicy, Game::StatsPolicy::MINIMAL>{}); return;
+            case Game::StatsPolicy::STANDARD:
+                fn(mode_tag, std::integral_constant<Game::StatsPolicy, Game::StatsPolicy::STANDARD>{}); return;
+            case Game::StatsPolicy::FULL:
+                fn(mode_tag, std::integral_constant<Game::StatsPolicy, Game::StatsPolicy::FULL>{}); return;
+        }
+    };
+    switch (mode) {
+        case Game::SimulationMode::FULL_GAME:
+            with_policy(std::integral_constant<Game::SimulationMode, Game::SimulationMode::FULL_GAME>{}); return;
+        case Game::SimulationMode::FG_ONLY:
+            with_policy(std::integral_constant<Game::SimulationMode, Game::SimulationMode::FG_ONLY>{}); return;
+        case Game::SimulationMode::BG_ONLY:
+            with_policy(std::integral_constant<Game::SimulationMode, Game::SimulationMode::BG_ONLY>{}); return;
+    }
+}
+
+// Fills block with the next n rounds. In FULL_GAME with skip_inert set, inert BG
+// rounds are only counted (block.inert_rounds) instead of stored as rows.
+// When items is set every round is played in full and counted into it, and
+// skip_inert is ignored.
+template <typename GameT, Game::SimulationMode Mode, Game::StatsPolicy Policy, typename RngT>
+static void fillBlock(RngT& rng, double second_chance_prob, size_t n, bool skip_inert,
+                      Game::ItemContributions* items, Game::GameResultBlock& block) {
+    if (items) {
+        GameT::template simulateGameRoundsTracked<Mode, Policy>(rng, second_chance_prob, n, block, *items);
+        return;
+    }
+    if constexpr (Mode == Game::SimulationMode::FULL_GAME) {
+        if (skip_inert) {
+            GameT::template simulateGameRoundsSkippingInert<Policy>(rng, second_chance_prob, n, block);
+            return;
+        }
+    }
+    GameT::template simulateGameRounds<Mode, Policy>(rng, second_chance_prob, n, block);
+}
+
+// Order of top-k entries: by value, ties broken towards the earlier round,
+// so the kept entries do not depend on which thread saw which round first.
+static bool ranksBelow(const TopRound& a, const TopRound& b) {
+    return a.value != b.value ? a.value < b.value : a.round > b.round;
+}
+
 // --- Helper function to keep a top-k list ---
-void updateTopValues(std::vector<double>& top_values, double new_value, size_t k) {
+void updateTopValues(std::vector<TopRound>& top_values, double new_value, long long round, size_t k) {
+    const TopRound entry{new_value, round};
     if (top_values.size() < k) {
-        top_values.push_back(new_value);
-        std::sort(top_values.begin(), top_values.end());
-    } else if (new_value > top_values[0]) {
-        top_values[0] = new_value;
-        std::sort(top_values.begin(), top_values.end());
+        top_values.push_back(entry);
+        std::sort(top_values.begin(), top_values.end(), ranksBelow);
+    } else if (ranksBelow(top_values[0], entry)) {
+        top_values[0] = entry;
+        std::sort(top_values.begin(), top_values.end(), ranksBelow);
     }
 }
 
 
 // --- MonteCarloSimulator Method Implementations ---
 
-MonteCarloSimulator::MonteCarloSimulator() {
-    unsigned seed = std::chrono::high_resolution_clock::now().time_since_epoch().count();
-    m_rng.seed(seed);
+template <typename GameT, typename RngT>
+MonteCarloSimulator<GameT, RngT>::MonteCarloSimulator() {
+    setSeed(std::chrono::high_resolution_clock::now().time_since_epoch().count());
+}
+
+template <typename GameT, typename RngT>
+void MonteCarloSimulator<GameT, RngT>::setSeed(uint64_t seed) {
+    m_seed = seed;
+    m_runs_started = 0;
+}
+
+template <typename GameT, typename RngT>
+void MonteCarloSimulator<GameT, RngT>::mergeChunkMoments(const std::vector<ChunkMoments>& chunks) {
+    m_final_online_stats = OnlineStats();
+    m_final_bg_online_stats = OnlineStats();
+    double bg_score = 0.0, fg_score = 0.0;
+    for (const ChunkMoments& chunk : chunks) {
+        m_final_online_stats.combine(chunk.total);
+        m_final_bg_online_stats.combine(chunk.bg);
+        bg_score += chunk.bg_score;
+        fg_score += chunk.fg_score;
+    }
+    m_total_bg_score = bg_score;
+    m_total_fg_score = fg_score;
+}
+
+// Keeps the merged counters of a run and, when they were tracked, its
+// histogram and top-k list (best first).
+template <typename GameT, typename RngT>
+void MonteCarloSimulator<GameT, RngT>::storeTotals(const Accumulator& totals) {
+    m_totals = totals;
+    if (totals.histogram.dividers.empty()) return;
+    m_histogram.bins = totals.histogram.bins;
+    m_histogram.underflow = totals.histogram.underflow;
+    m_histogram.overflow = totals.histogram.overflow;
+    m_top_values_tracker = totals.top_values;
+    std::sort(m_top_values_tracker.rbegin(), m_top_values_tracker.rend(), ranksBelow);
 }
 
-void MonteCarloSimulator::setCustomHistogramBins(std::vector<double>& dividers) {
+// Column passes over the block: the nonzero counts and histogram bins use the
+// SIMD helpers of SimdBatch.h, the rest are per-row integer updates. Every
+// result is an integer count, maximum or set of top rows, so it matches a
+// row-by-row pass exactly.
+template <Game::StatsPolicy Policy>
+void RoundAccumulator::addBlock(const Game::GameResultBlock& block, long long first_round) {
+    const size_t n = block.size;
+    // Per-thread scratch for the total scores and bin positions; grows once, then is reused.
+    thread_local Game::AlignedColumn<double> total_scores;
+    thread_local Game::AlignedColumn<int32_t> bin_ends;
+    if (total_scores.size() < n) {
+        total_scores.resize(n);
+        bin_ends.resize(n);
+    }
+    for (size_t j = 0; j < n; ++j) total_scores[j] = block.bg_score[j] + block.fg_score[j];
+
+    // Track nonzero frequencies
+    nonzero_bg += static_cast<long long>(Game::countNonzero(block.bg_score.data(), n));
+    nonzero_fg_sessions += static_cast<long long>(Game::countNonzero(block.fg_score.data(), n));  // Session-level tracking
+    nonzero_total += static_cast<long long>(Game::countNonzero(total_scores.data(), n));
+
+    if constexpr (Game::tracksRunStats<Policy>) {
+        for (size_t j = 0; j < n; ++j) {
+            nonzero_fg_picks += block.fg_nonzero_picks[j];  // Pick-level tracking
+            if (block.fg_dropped_picks[j] != 0) {  // Session that hit the FG cap
+                fg_capped_sessions++;
+                fg_dropped_picks += block.fg_dropped_picks[j];
+            }
+
+            // Track FG statistics
+            if (block.fg_was_triggered(j)) {
+                total_fg_picks += block.fg_run_length[j];
+                fg_triggered_count++;
+                if (block.fg_run_length[j] > 0) {
+                    total_fg_runs++;
+                    if (block.fg_run_length[j] > max_fg_length) max_fg_length = block.fg_run_length[j];
+                }
+            }
+
+            // Track max multipliers
+            if (block.max_bg_multiplier[j] > max_bg_multiplier) max_bg_multiplier = block.max_bg_multiplier[j];
+            if (block.max_fg_multiplier[j] > max_fg_multiplier) max_fg_multiplier = block.max_fg_multiplier[j];
+        }
+    }
+
+    if constexpr (Game::tracksLevelStats<Policy>) {
+        for (size_t j = 0; j < n; ++j) {
+            // Category 1: BG levels
+            total_bg_levels += block.bg_levels[j];
+            if (block.bg_levels[j] != 1) {
+                bg_nonzero_levels_sum += block.bg_levels[j];
+                bg_nonzero_levels_count++;
+            }
+            if (block.bg_levels[j] > max_bg_level) max_bg_level = block.bg_levels[j];
+
+            // Category 2: FG picks
+            total_fg_levels += block.fg_level_total[j];
+            fg_nonzero_levels_sum += block.fg_level_nonzero_sum[j];
+            fg_nonzero_levels_count += block.fg_level_nonzero_count[j];
+            if (block.fg_level_max[j] > max_fg_level) max_fg_level = block.fg_level_max[j];
+
+            // Category 3: Per run
+            total_run_levels += block.bg_levels[j] + block.fg_level_total[j];
+            run_nonzero_levels_sum += ((block.bg_levels[j] != 1) ? block.bg_levels[j] : 0) + block.fg_level_nonzero_sum[j];
+            run_nonzero_levels_count += ((block.bg_levels[j] != 1) ? 1 : 0) + block.fg_level_nonzero_count[j];
+            const int run_max_level = std::max(block.bg_levels[j], block.fg_level_max[j]);
+            if (run_max_level > max_run_level) max_run_level = run_max_level;
+        }
+    }
+
+    if (histogram.dividers.empty()) return;
+    const size_t num_dividers = histogram.dividers.size();
+    Game::upperBoundBatch(histogram.dividers.data(), num_dividers, total_scores.data(), n, bin_ends.data());
+    for (size_t j = 0; j < n; ++j) {
+        const double total_score = total_scores[j];
+        updateTopValues(top_values, total_score, first_round + static_cast<long long>(block.roundOffset(j)), 5);
+        if (total_score < 0) { histogram.underflow++; }
+        else if (static_cast<size_t>(bin_ends[j]) == num_dividers) { histogram.overflow++; }  // total_score >= dividers.back()
+        else { histogram.bins[bin_ends[j] - 1]++; }
+    }
+}
+
+template <Game::StatsPolicy Policy>
+void RoundAccumulator::addInert(long long count) {
+    // A zero score never displaces a real top-k entry, so only the histogram sees them.
+    if (!histogram.dividers.empty()) {
+        histogram.bins[0] += count;  // Zero always falls in the first bin [0, 1)
+    }
+    if constexpr (Game::tracksLevelStats<Policy>) {
+        total_bg_levels += count;
+        if (1 > max_bg_level) max_bg_level = 1;
+        total_run_levels += count;
+        if (1 > max_run_level) max_run_level = 1;
+    }
+}
+
+// Sums, maxima and the top-k order are all independent of merge order, so the
+// run total does not depend on which thread finishes first.
+void RoundAccumulator::merge(const RoundAccumulator& other) {
+    for (size_t j = 0; j < histogram.bins.size(); ++j) histogram.bins[j] += other.histogram.bins[j];
+    histogram.underflow += other.histogram.underflow;
+    histogram.overflow += other.histogram.overflow;
+    for (const TopRound& entry : other.top_values) updateTopValues(top_values, entry.value, entry.round, 5);
+    fg_triggered_count += other.fg_triggered_count;
+    total_fg_runs += other.total_fg_runs;
+    total_fg_picks += other.total_fg_picks;
+    nonzero_bg += other.nonzero_bg;
+    nonzero_fg_sessions += other.nonzero_fg_sessions;
+    nonzero_fg_picks += other.nonzero_fg_picks;
+    nonzero_total += other.nonzero_total;
+    fg_capped_sessions += other.fg_capped_sessions;
+    fg_dropped_picks += other.fg_dropped_picks;
+    total_bg_levels += other.total_bg_levels;
+    bg_nonzero_levels_sum += other.bg_nonzero_levels_sum;
+    bg_nonzero_levels_count += other.bg_nonzero_levels_count;
+    total_fg_levels += other.total_fg_levels;
+    fg_nonzero_levels_sum += other.fg_nonzero_levels_sum;
+    fg_nonzero_levels_count += other.fg_nonzero_levels_count;
+    total_run_levels += other.total_run_levels;
+    run_nonzero_levels_sum += other.run_nonzero_levels_sum;
+    run_nonzero_levels_count += other.run_nonzero_levels_count;
+    max_fg_length = std::max(max_fg_length, other.max_fg_length);
+    max_bg_multiplier = std::max(max_bg_multiplier, other.max_bg_multiplier);
+    max_fg_multiplier = std::max(max_fg_multiplier, other.max_fg_multiplier);
+    max_bg_level = std::max(max_bg_level, other.max_bg_level);
+    max_fg_level = std::max(max_fg_level, other.max_fg_level);
+    max_run_level = std::max(max_run_level, other.max_run_level);
+}
+
+template void RoundAccumulator::addBlock<Game::StatsPolicy::MINIMAL>(const Game::GameResultBlock&, long long);
+template void RoundAccumulator::addBlock<Game::StatsPolicy::STANDARD>(const Game::GameResultBlock&, long long);
+template void RoundAccumulator::addBlock<Game::StatsPolicy::FULL>(const Game::GameResultBlock&, long long);
+template void RoundAccumulator::addInert<Game::StatsPolicy::MINIMAL>(long long);
+template void RoundAccumulator::addInert<Game::StatsPolicy::STANDARD>(long long);
+template void RoundAccumulator::addInert<Game::StatsPolicy::FULL>(long long);
+
+template <typename GameT, typename RngT>
+void MonteCarloSimulator<GameT, RngT>::setCustomHistogramBins(std::vector<double>& dividers) {
     if (dividers.empty() || dividers.front() < 1.0) {
         throw std::invalid_argument("Custom dividers must not be empty and must start with a value >= 1.");
     }
@@ -75,7 +322,8 @@ void MonteCarloSimulator::setCustomHistogramBins(std::vector<double>& dividers)
     std::cout << "[Config] Custom histogram configured with " << m_histogram.bins.size() << " bins." << std::endl;
 }
 
-void MonteCarloSimulator::setProgressiveHistogramBins() {
+template <typename GameT, typename RngT>
+void MonteCarloSimulator<GameT, RngT>::setProgressiveHistogramBins() {
     std::vector<double> dividers;
     for (double val = 5; val <= 100; val += 5) dividers.push_back(val);
     for (double val = 110; val <= 500; val += 10) dividers.push_back(val);
@@ -85,7 +333,8 @@ void MonteCarloSimulator::setProgressiveHistogramBins() {
     std::cout << "[Config] Progressive histogram configured." << std::endl;
 }
 
-void MonteCarloSimulator::setFixedWidthHistogramBins(double max_val, int num_bins) {
+template <typename GameT, typename RngT>
+void MonteCarloSimulator<GameT, RngT>::setFixedWidthHistogramBins(double max_val, int num_bins) {
     if (max_val <= 1 || num_bins < 1) {
         throw std::invalid_argument("Max value must be > 1 and num_bins must be > 0.");
     }
@@ -99,7 +348,8 @@ void MonteCarloSimulator::setFixedWidthHistogramBins(double max_val, int num_bin
 }
 
 // --- State Management ---
-void MonteCarloSimulator::resetState() {
+template <typename GameT, typename RngT>
+void MonteCarloSimulator<GameT, RngT>::resetState() {
     m_stats = Stats();
     m_results.clear();
     m_final_online_stats = OnlineStats();
@@ -108,19 +358,11 @@ void MonteCarloSimulator::resetState() {
     m_batch_means.clear();
     m_bootstrap_means.clear();
 
-    // Reset levels statistics
-    m_total_bg_levels = 0;
-    m_bg_nonzero_levels_sum = 0;
-    m_bg_nonzero_levels_count = 0;
-    m_max_bg_level = 0;
-    m_total_fg_levels = 0;
-    m_fg_nonzero_levels_sum = 0;
-    m_fg_nonzero_levels_count = 0;
-    m_max_fg_level = 0;
-    m_total_run_levels = 0;
-    m_run_nonzero_levels_sum = 0;
-    m_run_nonzero_levels_count = 0;
-    m_max_run_level = 0;
+    m_totals = Accumulator();
+    m_total_bg_score = 0.0;
+    m_total_fg_score = 0.0;
+
+    m_item_contributions = m_track_items ? GameT::makeItemContributions() : Game::ItemContributions();
 
     if (m_histogram_configured) {
         m_histogram.bins.assign(m_histogram.dividers.size() - 1, 0);
@@ -129,101 +371,46 @@ void MonteCarloSimulator::resetState() {
     }
 }
 
-void MonteCarloSimulator::run(long long numSimulations, Game::SimulationMode sim_mode, MemoryMode mem_mode, bool useParallel, double second_chance_prob) {
+template <typename GameT, typename RngT>
+void MonteCarloSimulator<GameT, RngT>::run(long long numSimulations, Game::SimulationMode sim_mode, MemoryMode mem_mode, bool useParallel, double second_chance_prob) {
     resetState();
 
     m_mode = mem_mode;
     m_stats = Stats();
-    m_total_fg_runs = 0;
-    m_total_fg_picks = 0;
-    m_max_fg_length = 0;
-    m_fg_triggered_count = 0; // Reset all stats at the beginning of a run.
-    m_nonzero_bg_count = 0;
-    m_nonzero_fg_sessions_count = 0;
-    m_nonzero_fg_picks_count = 0;
-    m_nonzero_total_count = 0;
-    m_max_bg_multiplier = 1;
-    m_max_fg_multiplier = 1;
-
-    // Reset levels statistics
-    m_total_bg_levels = 0;
-    m_bg_nonzero_levels_sum = 0;
-    m_bg_nonzero_levels_count = 0;
-    m_max_bg_level = 0;
-    m_total_fg_levels = 0;
-    m_fg_nonzero_levels_sum = 0;
-    m_fg_nonzero_levels_count = 0;
-    m_max_fg_level = 0;
-    m_total_run_levels = 0;
-    m_run_nonzero_levels_sum = 0;
-    m_run_nonzero_levels_count = 0;
-    m_max_run_level = 0;
-
-    // --- Calculate average BG value for later use ---
-    m_total_bg_score = 0.0;
-    m_total_fg_score = 0.0;
-
 
     if (!m_histogram_configured) {
         std::cout << "[Config] No histogram specified, using default Progressive Bins." << std::endl;
         setProgressiveHistogramBins();
     }
-    // --- Adjust simulation count for FG_ONLY mode ---
-    long long effective_simulations = numSimulations;
-    if (sim_mode == Game::SimulationMode::FG_ONLY) {
-        effective_simulations /= 10;
-        if (effective_simulations == 0 && numSimulations > 0) effective_simulations = 1; // Ensure at least one run
-        std::cout << "[Monitor] FG_ONLY mode selected. Adjusting total simulation rounds to " << effective_simulations 
-                  << " for comparable FG event count." << std::endl;
-    }
+    beginRun(sim_mode, second_chance_prob);
+    m_layout = makeLayout(m_runs_started, sim_mode, mem_mode, second_chance_prob, numSimulations, kRoundsPerChunk);
 
-    if (!useParallel) {
-        std::cout << "\n[Monitor] Running in SINGLE-THREADED mode." << std::endl;
-        if (mem_mode == MemoryMode::EFFICIENT) { runEfficientMode_SingleThread(effective_simulations, sim_mode, second_chance_prob); } 
-        else { runAccurateMode_SingleThread(effective_simulations, sim_mode, second_chance_prob); }
-        return;
+    if (m_skip_inert_bg && (sim_mode != Game::SimulationMode::FULL_GAME || mem_mode != MemoryMode::EFFICIENT)) {
+        std::cout << "[Config] Inert BG skip-ahead only applies to FULL_GAME in EFFICIENT mode; running without it." << std::endl;
     }
-    
-    std::cout << "\n[Monitor] Running in PARALLEL mode." << std::endl;
-    if (mem_mode == MemoryMode::EFFICIENT) { runEfficientMode_Parallel(effective_simulations, sim_mode, second_chance_prob); } 
-    else { runAccurateMode_Parallel(effective_simulations, sim_mode, second_chance_prob); }
+    prepareFGSessionCache(sim_mode);
+    std::cout << (useParallel ? "\n[Monitor] Running in PARALLEL mode." : "\n[Monitor] Running in SINGLE-THREADED mode.") << std::endl;
+    dispatchKernel(sim_mode, m_stats_policy, [&](auto mode_tag, auto policy_tag) {
+        constexpr Game::SimulationMode Mode = decltype(mode_tag)::value;
+        constexpr Game::StatsPolicy Policy = decltype(policy_tag)::value;
+        if (!useParallel) {
+            if (mem_mode == MemoryMode::EFFICIENT) { runEfficientMode_SingleThread<Mode, Policy>(numSimulations, second_chance_prob); }
+            else { runAccurateMode_SingleThread<Mode, Policy>(numSimulations, second_chance_prob); }
+            return;
+        }
+        if (mem_mode == MemoryMode::EFFICIENT) { runEfficientMode_Parallel<Mode, Policy>(numSimulations, second_chance_prob); }
+        else { runAccurateMode_Parallel<Mode, Policy>(numSimulations, second_chance_prob); }
+    });
 
 }
 
 // --- HIGHLIGHT: Main run function updated to accept k and m ---
-void MonteCarloSimulator::run(long long k, long long m, Game::SimulationMode sim_mode, MemoryMode mode, bool useParallel, double second_chance_prob) {
+template <typename GameT, typename RngT>
+void MonteCarloSimulator<GameT, RngT>::run(long long k, long long m, Game::SimulationMode sim_mode, MemoryMode mode, bool useParallel, double second_chance_prob) {
     resetState(); // Clear all previous state including batch_means and bootstrap_means
 
     m_mode = mode;
     m_stats = Stats();
-    m_total_fg_runs = 0;
-    m_total_fg_picks = 0;
-    m_max_fg_length = 0;
-    m_fg_triggered_count = 0; // Reset all stats at the beginning of a run.
-    m_nonzero_bg_count = 0;
-    m_nonzero_fg_sessions_count = 0;
-    m_nonzero_fg_picks_count = 0;
-    m_nonzero_total_count = 0;
-    m_max_bg_multiplier = 1;
-    m_max_fg_multiplier = 1;
-
-    // Reset levels statistics
-    m_total_bg_levels = 0;
-    m_bg_nonzero_levels_sum = 0;
-    m_bg_nonzero_levels_count = 0;
-    m_max_bg_level = 0;
-    m_total_fg_levels = 0;
-    m_fg_nonzero_levels_sum = 0;
-    m_fg_nonzero_levels_count = 0;
-    m_max_fg_level = 0;
-    m_total_run_levels = 0;
-    m_run_nonzero_levels_sum = 0;
-    m_run_nonzero_levels_count = 0;
-    m_max_run_level = 0;
-
-    // --- Calculate average BG value for later use ---
-    m_total_bg_score = 0.0;
-    m_total_fg_score = 0.0;
 
     if (!m_histogram_configured) {
         std::cout << "[Config] No histogram specified, using default Progressive Bins." << std::endl;
@@ -237,46 +424,209 @@ void MonteCarloSimulator::run(long long k, long long m, Game::SimulationMode sim
         throw std::invalid_argument("Total number of simulations (k * m) must be positive.");
     }
 
+    beginRun(sim_mode, second_chance_prob);
+    m_layout = makeLayout(m_runs_started, sim_mode, mode, second_chance_prob, numSimulations, m);
+
+    if (m_skip_inert_bg && (sim_mode != Game::SimulationMode::FULL_GAME || mode != MemoryMode::EFFICIENT)) {
+        std::cout << "[Config] Inert BG skip-ahead only applies to FULL_GAME in EFFICIENT mode; running without it." << std::endl;
+    }
+    prepareFGSessionCache(sim_mode);
+    std::cout << (useParallel ? "\n[Monitor] Running in PARALLEL mode." : "\n[Monitor] Running in SINGLE-THREADED mode.") << std::endl;
+    dispatchKernel(sim_mode, m_stats_policy, [&](auto mode_tag, auto policy_tag) {
+        constexpr Game::SimulationMode Mode = decltype(mode_tag)::value;
+        constexpr Game::StatsPolicy Policy = decltype(policy_tag)::value;
+        if (!useParallel) {
+            if (mode == MemoryMode::EFFICIENT) { runEfficientMode_SingleThread<Mode, Policy>(numBatches, numRounds, second_chance_prob); }
+            else { runAccurateMode_SingleThread<Mode, Policy>(numBatches, numRounds, second_chance_prob); }
+            return;
+        }
+        if (mode == MemoryMode::EFFICIENT) { runEfficientMode_Parallel<Mode, Policy>(numBatches, numRounds, second_chance_prob); }
+        else { runAccurateMode_Parallel<Mode, Policy>(numBatches, numRounds, second_chance_prob); }
+    });
+}
+
+
+
+
+// Records the mode of a run for the report and derives its seed. FG_ONLY
+// rounds are taken as given: each plays exactly one FG session, with initial
+// picks drawn by the game's FG_ONLY start rule, so no round count is rescaled.
+template <typename GameT, typename RngT>
+void MonteCarloSimulator<GameT, RngT>::beginRun(Game::SimulationMode sim_mode, double second_chance_prob) {
+    m_runs_started++;
+    m_run_seed = runSeed(m_runs_started);
+    std::cout << "[Monitor] Seed " << m_seed << ", run " << m_runs_started << " (rerun with the same seed to reproduce)." << std::endl;
+    m_sim_mode = sim_mode;
+    m_fg_entry_probability = GameT::fgEntryProbability(second_chance_prob);
+    m_two_phase = TwoPhaseEstimate();
     if (sim_mode == Game::SimulationMode::FG_ONLY) {
-        // IMPORTANT: In FG_ONLY mode, we reduce the rounds per batch (m) by 10x
-        // to maintain a comparable number of FG events per simulation.
-        // This keeps k (number of batches) constant, which maintains the
-        // statistical power of the confidence interval calculation.
-        //
-        // Rationale:
-        //   - In FULL_GAME mode, only ~10% of rounds trigger FG
-        //   - In FG_ONLY mode, 100% of rounds have FG
-        //   - Reducing m by 10x gives similar FG event counts
-        //   - Keeping k constant preserves CI accuracy (degrees of freedom)
-        //
-        // Example: k=100, m=10,000 in FULL_GAME mode
-        //       → k=100, m=1,000 in FG_ONLY mode
-        //       → Both have 100 batches for CI calculation
-        //       → FG_ONLY has shorter batches but same number of batches
-        numRounds /= 10;
-        if (numRounds == 0 && numSimulations > 0) {
-            numRounds = 1; // Ensure at least one round per batch
+        std::cout << "[Monitor] FG_ONLY mode: every round plays one FG session";
+        if (GameT::fgOnlyStartsAtBGEntry()) {
+            std::cout << ", started as FULL_GAME rounds enter FG (entry probability "
+                      << m_fg_entry_probability << ")";
         }
-        numSimulations = numRounds * numBatches;
-        std::cout << "[Monitor] FG_ONLY mode selected." << std::endl;
-        std::cout << "[Monitor] Adjusting rounds per batch from " << m << " to " << numRounds
-                  << " for comparable FG event count." << std::endl;
-        std::cout << "[Monitor] Total simulations: " << numSimulations
-                  << " (" << numBatches << " batches × " << numRounds << " rounds/batch)" << std::endl;
+        std::cout << "." << std::endl;
     }
+}
 
-    if (!useParallel) {
-        std::cout << "\n[Monitor] Running in SINGLE-THREADED mode." << std::endl;
-        if (mode == MemoryMode::EFFICIENT) { runEfficientMode_SingleThread(numBatches, numRounds, sim_mode, second_chance_prob); } 
-        else { runAccurateMode_SingleThread(numBatches, numRounds, sim_mode, second_chance_prob); }
-        return;
+// Run n of a seed uses the n-th SplitMix64 output, so consecutive runs
+// (e.g. the two passes of runTwoPhase) draw from unrelated streams.
+template <typename GameT, typename RngT>
+uint64_t MonteCarloSimulator<GameT, RngT>::runSeed(uint64_t run) const {
+    uint64_t state = m_seed + (run - 1) * 0x9E3779B97F4A7C15ULL;
+    return Game::splitMix64(state);
+}
+
+template <typename GameT, typename RngT>
+typename MonteCarloSimulator<GameT, RngT>::RunLayout
+MonteCarloSimulator<GameT, RngT>::makeLayout(uint64_t run, Game::SimulationMode sim_mode, MemoryMode mem_mode,
+                                             double second_chance_prob, long long rounds, long long rounds_per_stream) const {
+    RunLayout layout;
+    layout.seed = m_seed;
+    layout.run = run;
+    layout.run_seed = runSeed(run);
+    layout.mode = sim_mode;
+    layout.second_chance_prob = second_chance_prob;
+    layout.rounds = rounds;
+    layout.rounds_per_stream = rounds_per_stream;
+    // Tracked runs play every round in full whatever the other settings.
+    if (!m_track_items && sim_mode == Game::SimulationMode::FULL_GAME) {
+        if (m_skip_inert_bg && mem_mode == MemoryMode::EFFICIENT) {
+            layout.not_replayable = "inert BG skip-ahead draws the gaps between eventful rounds, not the rounds";
+        } else if (m_fg_cache_sessions > 0) {
+            layout.not_replayable = "its FG sessions were drawn from the FG session cache";
+        }
     }
-    std::cout << "\n[Monitor] Running in PARALLEL mode." << std::endl;
-    if (mode == MemoryMode::EFFICIENT) { runEfficientMode_Parallel(numBatches, numRounds, sim_mode, second_chance_prob); } 
-    else { runAccurateMode_Parallel(numBatches, numRounds, sim_mode, second_chance_prob); }
+    return layout;
 }
 
+template <typename GameT, typename RngT>
+Game::RoundTrace MonteCarloSimulator<GameT, RngT>::replayRound(long long round_index) const {
+    if (m_layout.rounds == 0) {
+        throw std::runtime_error("No run to replay: replayRound(round) needs a completed run().");
+    }
+    return replayRound(m_layout, round_index);
+}
 
+template <typename GameT, typename RngT>
+Game::RoundTrace MonteCarloSimulator<GameT, RngT>::replayRound(long long k, long long m, Game::SimulationMode sim_mode, MemoryMode mem_mode,
+                                                               double second_chance_prob, long long round_index, uint64_t run) const {
+    if (k <= 0 || m <= 0 || run == 0) {
+        throw std::invalid_argument("replayRound needs positive k, m and run number.");
+    }
+    return replayRound(makeLayout(run, sim_mode, mem_mode, second_chance_prob, k * m, m), round_index);
+}
+
+template <typename GameT, typename RngT>
+Game::RoundTrace MonteCarloSimulator<GameT, RngT>::replayRound(const RunLayout& layout, long long round_index) const {
+    if (!layout.replayable()) {
+        throw std::runtime_error(std::string("Rounds of this run cannot be replayed: ") + layout.not_replayable + ".");
+    }
+    if (round_index < 0 || round_index >= layout.rounds) {
+        throw std::runtime_error("Round " + std::to_string(round_index) + " is outside the run (" +
+                                 std::to_string(layout.rounds) + " rounds).");
+    }
+    auto start_time = std::chrono::high_resolution_clock::now();
+    const long long stream = round_index / layout.rounds_per_stream;
+    const long long offset = round_index % layout.rounds_per_stream;
+
+    // Fast-forward the round's stream to it. The tracked kernel draws exactly
+    // like the run's kernels but never reads the FG session cache, so a cache
+    // held for other runs cannot shift the draws.
+    RngT rng(layout.run_seed, static_cast<uint64_t>(stream));
+    Game::GameResultBlock block;
+    Game::ItemContributions scratch = GameT::makeItemContributions();
+    dispatchKernel(layout.mode, Game::StatsPolicy::MINIMAL, [&](auto mode_tag, auto policy_tag) {
+        constexpr Game::SimulationMode Mode = decltype(mode_tag)::value;
+        constexpr Game::StatsPolicy Policy = decltype(policy_tag)::value;
+        for (long long done = 0; done < offset; done += kRoundsPerBlock) {
+            const size_t n = static_cast<size_t>(std::min(kRoundsPerBlock, offset - done));
+            GameT::template simulateGameRoundsTracked<Mode, Policy>(rng, layout.second_chance_prob, n, block, scratch);
+        }
+    });
+
+    Game::RoundTrace trace;
+    const auto result = GameT::simulateGameRound(rng, layout.mode, layout.second_chance_prob, trace);
+    std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - start_time;
+
+    std::cout << "\n------ Replay of Round " << round_index << " ------" << std::endl;
+    std::cout << "Seed " << layout.seed << ", run " << layout.run << "; stream " << stream
+              << ", round " << offset << " of it (replayed in " << elapsed.count() << " seconds)" << std::endl;
+    if (trace.bg_class >= 0) {
+        std::cout << "BG:  class " << trace.bg_class << " (" << GameT::describeBGClass(trace.bg_class)
+                  << "), pays " << trace.bg_value << std::endl;
+    }
+    if (result.fg_was_triggered) {
+        std::cout << "FG:  " << trace.fg_picks.size() << " picks" << std::endl;
+        for (size_t i = 0; i < trace.fg_picks.size(); ++i) {
+            const Game::RoundTrace::FGPick& pick = trace.fg_picks[i];
+            std::cout << "  " << std::setw(4) << i + 1 << ". row " << pick.fg_row << " (" << GameT::describeFGRow(pick.fg_row)
+                      << "): level " << pick.level << ", multiplier " << pick.multiplier
+                      << ", retriggers " << pick.retrigger_picks << ", pays " << pick.value << std::endl;
+        }
+        if (result.fg_dropped_picks > 0) {
+            std::cout << "     " << result.fg_dropped_picks << " picks dropped by the FG cap" << std::endl;
+        }
+    }
+    std::cout << "Total: " << result.bg_score + result.fg_score << " (BG " << result.bg_score
+              << " + FG " << result.fg_score << ")" << std::endl;
+    return trace;
+}
+
+template <typename GameT, typename RngT>
+void MonteCarloSimulator<GameT, RngT>::runTwoPhase(long long k, long long m_bg, long long m_fg, MemoryMode mem_mode, bool useParallel, double second_chance_prob) {
+    if (!GameT::fgOnlyStartsAtBGEntry()) {
+        throw std::runtime_error("Two-phase estimation needs FG_ONLY rounds to start as FULL_GAME rounds enter FG "
+                                 "(fg_rules.fg_only_start \"bg_entry\").");
+    }
+    // Standard error of the mean of the last run; rounds are independent.
+    auto std_error = [this]() {
+        return m_stats.count > 0 ? m_stats.stdDev / std::sqrt(static_cast<double>(m_stats.count)) : 0.0;
+    };
+
+    std::cout << "\n[Monitor] Two-phase estimate, phase 1 of 2: BG_ONLY." << std::endl;
+    run(k, m_bg, Game::SimulationMode::BG_ONLY, mem_mode, useParallel, second_chance_prob);
+    TwoPhaseEstimate estimate;
+    estimate.bg_mean = m_stats.mean;
+    estimate.bg_std_error = std_error();
+    estimate.bg_rounds = m_stats.count;
+
+    std::cout << "\n[Monitor] Two-phase estimate, phase 2 of 2: FG_ONLY." << std::endl;
+    run(k, m_fg, Game::SimulationMode::FG_ONLY, mem_mode, useParallel, second_chance_prob);
+    estimate.fg_mean = m_stats.mean;
+    estimate.fg_std_error = std_error();
+    estimate.fg_sessions = m_stats.count;
+    estimate.fg_entry_probability = m_fg_entry_probability;
+
+    // The passes are independent, so their variances add.
+    const double p = estimate.fg_entry_probability;
+    estimate.mean = estimate.bg_mean + p * estimate.fg_mean;
+    estimate.std_error = std::sqrt(estimate.bg_std_error * estimate.bg_std_error + p * p * estimate.fg_std_error * estimate.fg_std_error);
+    estimate.valid = true;
+    m_two_phase = estimate;
+}
+
+// Builds, keeps or discards the game's FG session cache for the coming run.
+// Only FULL_GAME uses it; FG_ONLY would just resample the cache itself.
+template <typename GameT, typename RngT>
+void MonteCarloSimulator<GameT, RngT>::prepareFGSessionCache(Game::SimulationMode sim_mode) {
+    RngT cache_rng(m_run_seed, kFGCacheStream);
+    if (m_fg_cache_sessions == 0 || sim_mode != Game::SimulationMode::FULL_GAME) {
+        if (m_fg_cache_sessions > 0) {
+            std::cout << "[Config] FG session cache only applies to FULL_GAME; running without it." << std::endl;
+        }
+        GameT::buildFGSessionCache(cache_rng, 0);
+        return;
+    }
+    if (GameT::fgSessionCacheSize() == m_fg_cache_sessions) {
+        std::cout << "[Config] Fast BG sweep: reusing the FG session cache (" << m_fg_cache_sessions
+                  << " sessions per trigger count)." << std::endl;
+        return;
+    }
+    std::cout << "[Config] Fast BG sweep: pre-simulating " << m_fg_cache_sessions
+              << " FG sessions per trigger count..." << std::endl;
+    GameT::buildFGSessionCache(cache_rng, m_fg_cache_sessions);
+}
 
 
 // --- MonteCarloSimulator Run Modes Method Implementations ---
@@ -285,108 +635,58 @@ void MonteCarloSimulator::run(long long k, long long m, Game::SimulationMode sim
 // --- Single-Threaded Runners ---
 
 // Fallback Implementation without CI
-void MonteCarloSimulator::runEfficientMode_SingleThread(long long numSimulations, Game::SimulationMode sim_mode, double second_chance_prob) {
+template <typename GameT, typename RngT>
+template <Game::SimulationMode Mode, Game::StatsPolicy Policy>
+void MonteCarloSimulator<GameT, RngT>::runEfficientMode_SingleThread(long long numSimulations, double second_chance_prob) {
     std::cout << "[Monitor] Starting simulation in EFFICIENT memory mode." << std::endl;
     auto start_sim_time = std::chrono::high_resolution_clock::now();
-    m_final_online_stats = OnlineStats();
-    m_top_values_tracker.clear();
-    m_histogram.bins.assign(m_histogram.dividers.size() - 1, 0);
-    m_histogram.underflow = 0; m_histogram.overflow = 0;
+    Accumulator totals(m_histogram.dividers);
 
     const long long progress_interval = numSimulations > 20 ? numSimulations / 20 : 1;
-
-    for (long long i = 0; i < numSimulations; ++i) {
-        Game::GameResult result = Game::simulateGameRound(m_rng, sim_mode, second_chance_prob);
-        double total_score = result.bg_score + result.fg_score;
-
-        m_final_online_stats.update(total_score);
-        m_final_bg_online_stats.update(result.bg_score);
-        updateTopValues(m_top_values_tracker, total_score, 5);
-
-        m_total_bg_score = m_total_bg_score.load() + result.bg_score;
-        m_total_fg_score = m_total_fg_score.load() + result.fg_score;
-
-        // Track nonzero frequencies
-        if (result.bg_score != 0) m_nonzero_bg_count++;
-        if (result.fg_score != 0) m_nonzero_fg_sessions_count++;  // Session-level tracking
-        if (total_score != 0) m_nonzero_total_count++;
-        m_nonzero_fg_picks_count += result.fg_nonzero_picks;  // Pick-level tracking
-
-        // Track FG statistics
-        if (result.fg_was_triggered) {
-            m_total_fg_picks += result.fg_run_length;
-            m_fg_triggered_count++;
-            if (result.fg_run_length > 0) {
-                m_total_fg_runs++;
-                if (result.fg_run_length > m_max_fg_length) {
-                    m_max_fg_length = result.fg_run_length;
-                }
+    const long long num_chunks = (numSimulations + kRoundsPerChunk - 1) / kRoundsPerChunk;
+    std::vector<ChunkMoments> chunk_moments(num_chunks);
+    Game::ChunkOrderedMerge<Game::ItemContributions> item_merge(num_chunks);  // Item counters of each chunk
+
+    Game::GameResultBlock block;
+    Game::ItemContributions chunk_items;
+    Game::ItemContributions* items = m_track_items ? &chunk_items : nullptr;
+    for (long long c = 0; c < num_chunks; ++c) {
+        RngT rng(m_run_seed, static_cast<uint64_t>(c));  // Stream of this chunk
+        ChunkMoments& moments = chunk_moments[c];
+        if (items) chunk_items = GameT::makeItemContributions();
+        const long long chunk_end = std::min(numSimulations, (c + 1) * kRoundsPerChunk);
+        for (long long start = c * kRoundsPerChunk; start < chunk_end; start += kRoundsPerBlock) {
+            const size_t n = static_cast<size_t>(std::min(kRoundsPerBlock, chunk_end - start));
+            fillBlock<GameT, Mode, Policy>(rng, second_chance_prob, n, m_skip_inert_bg, items, block);
+
+            for (size_t j = 0; j < block.size; ++j) {
+                double total_score = block.bg_score[j] + block.fg_score[j];
+
+                moments.total.update(total_score);
+                moments.bg.update(block.bg_score[j]);
+                moments.bg_score += block.bg_score[j];
+                moments.fg_score += block.fg_score[j];
             }
-        }
-
-        // Track max multipliers
-        if (result.max_bg_multiplier > m_max_bg_multiplier) m_max_bg_multiplier = result.max_bg_multiplier;
-        if (result.max_fg_multiplier > m_max_fg_multiplier) m_max_fg_multiplier = result.max_fg_multiplier;
-
-        // Track levels statistics
-        // Category 1: BG levels
-        m_total_bg_levels += result.bg_levels;
-        if (result.bg_levels != 1) {
-            m_bg_nonzero_levels_sum += result.bg_levels;
-            m_bg_nonzero_levels_count++;
-        }
-        if (result.bg_levels > m_max_bg_level) {
-            m_max_bg_level = result.bg_levels;
-        }
-
-        // Category 2: FG picks
-        int run_max_fg_level = 0;
-        for (int fg_level : result.fg_levels) {
-            m_total_fg_levels += fg_level;
-            if (fg_level != 1) {
-                m_fg_nonzero_levels_sum += fg_level;
-                m_fg_nonzero_levels_count++;
+            totals.template addBlock<Policy>(block, start);
+
+            // Inert rounds skipped by the sampler: zero score, BG level 1, no FG.
+            if (block.inert_rounds > 0) {
+                const long long inert = static_cast<long long>(block.inert_rounds);
+                moments.total.updateRepeated(0.0, inert);
+                moments.bg.updateRepeated(0.0, inert);
+                totals.template addInert<Policy>(inert);
             }
-            if (fg_level > run_max_fg_level) run_max_fg_level = fg_level;
-        }
-        if (run_max_fg_level > m_max_fg_level) {
-            m_max_fg_level = run_max_fg_level;
-        }
 
-        // Category 3: Per run
-        long long run_total_levels = result.bg_levels;
-        long long run_nonzero_sum = (result.bg_levels != 1) ? result.bg_levels : 0;
-        long long run_nonzero_count = (result.bg_levels != 1) ? 1 : 0;
-        int run_max_level = result.bg_levels;
-
-        for (int fg_level : result.fg_levels) {
-            run_total_levels += fg_level;
-            if (fg_level != 1) {
-                run_nonzero_sum += fg_level;
-                run_nonzero_count++;
+            const long long done = start + static_cast<long long>(n);
+            if (done / progress_interval != start / progress_interval) {
+                std::cout << "          ... Progress: " << (100 * done / numSimulations) << "% complete." << std::endl;
             }
-            if (fg_level > run_max_level) run_max_level = fg_level;
-        }
-
-        m_total_run_levels += run_total_levels;
-        m_run_nonzero_levels_sum += run_nonzero_sum;
-        m_run_nonzero_levels_count += run_nonzero_count;
-        if (run_max_level > m_max_run_level) {
-            m_max_run_level = run_max_level;
-        }
-
-        if (total_score < 0) { m_histogram.underflow++; } 
-        else if (total_score >= m_histogram.dividers.back()) { m_histogram.overflow++; } 
-        else {
-            auto it = std::upper_bound(m_histogram.dividers.begin(), m_histogram.dividers.end(), total_score);
-            int bin_index = std::distance(m_histogram.dividers.begin(), it) - 1;
-            m_histogram.bins[bin_index]++;
-        }
-
-        if ((i + 1) % progress_interval == 0) {
-            std::cout << "          ... Progress: " << (100 * (i + 1) / numSimulations) << "% complete." << std::endl;
         }
+        if (items) item_merge.add(c, std::move(chunk_items));
     }
+    mergeChunkMoments(chunk_moments);
+    if (items) m_item_contributions.merge(item_merge.total());
+    storeTotals(totals);
     auto end_sim_time = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double> sim_elapsed = end_sim_time - start_sim_time;
     std::cout << "[Monitor] Simulation loop finished in " << sim_elapsed.count() << " seconds." << std::endl;
@@ -394,125 +694,59 @@ void MonteCarloSimulator::runEfficientMode_SingleThread(long long numSimulations
 }
 
 // New EfficientMode with batch calculation of CI
-void MonteCarloSimulator::runEfficientMode_SingleThread(long long k, long long m, Game::SimulationMode sim_mode, double second_chance_prob) {
+template <typename GameT, typename RngT>
+template <Game::SimulationMode Mode, Game::StatsPolicy Policy>
+void MonteCarloSimulator<GameT, RngT>::runEfficientMode_SingleThread(long long k, long long m, double second_chance_prob) {
     std::cout << "[Monitor] Starting simulation in EFFICIENT memory mode with batch-level structure." << std::endl;
     std::cout << "[Monitor] Configuration: " << k << " batches × " << m << " rounds/batch = " << (k * m) << " total rounds" << std::endl;
     auto start_sim_time = std::chrono::high_resolution_clock::now();
 
-    m_final_online_stats = OnlineStats();
-    m_top_values_tracker.clear();
-    m_histogram.bins.assign(m_histogram.dividers.size() - 1, 0);
-    m_histogram.underflow = 0;
-    m_histogram.overflow = 0;
-
+    Accumulator totals(m_histogram.dividers);
     const long long progress_interval_batches = k > 100 ? k / 100 : 1;
 
+    std::vector<ChunkMoments> chunk_moments(k);  // One chunk per batch
+    Game::ChunkOrderedMerge<Game::ItemContributions> item_merge(k);  // Item counters of each batch
+    Game::GameResultBlock block;
+    Game::ItemContributions batch_items;
+    Game::ItemContributions* items = m_track_items ? &batch_items : nullptr;
+
     // BATCH-LEVEL LOOP: Process batches sequentially
     for (long long batch = 0; batch < k; ++batch) {
-        OnlineStats batch_stats; // Fresh statistics for this batch
+        RngT rng(m_run_seed, static_cast<uint64_t>(batch));  // Stream of this batch
+        ChunkMoments& moments = chunk_moments[batch];
+        if (items) batch_items = GameT::makeItemContributions();
 
         // INNER LOOP: Process all rounds in this batch
-        for (long long round = 0; round < m; ++round) {
-            Game::GameResult result = Game::simulateGameRound(m_rng, sim_mode, second_chance_prob);
-            double total_score = result.bg_score + result.fg_score;
-
-            // UPDATE 1: Overall statistics (for all rounds across all batches)
-            m_final_online_stats.update(total_score);
-            m_final_bg_online_stats.update(result.bg_score);
-
-            // UPDATE 2: Batch statistics (for this specific batch)
-            batch_stats.update(total_score);
-
-            // UPDATE 3: Top values tracking
-            updateTopValues(m_top_values_tracker, total_score, 5);
-
-            // UPDATE 4: BG/FG score contributions
-            m_total_bg_score = m_total_bg_score.load() + result.bg_score;
-            m_total_fg_score = m_total_fg_score.load() + result.fg_score;
-
-            // UPDATE 5: Track nonzero frequencies
-            if (result.bg_score != 0) m_nonzero_bg_count++;
-            if (result.fg_score != 0) m_nonzero_fg_sessions_count++;  // Session-level tracking
-            if (total_score != 0) m_nonzero_total_count++;
-            m_nonzero_fg_picks_count += result.fg_nonzero_picks;  // Pick-level tracking
-
-            // UPDATE 6: FG statistics (trigger count, run lengths)
-            if (result.fg_was_triggered) {
-                m_total_fg_picks += result.fg_run_length;
-                m_fg_triggered_count++;
-                if (result.fg_run_length > 0) {
-                    m_total_fg_runs++;
-                    if (result.fg_run_length > m_max_fg_length) {
-                        m_max_fg_length = result.fg_run_length;
-                    }
-                }
-            }
+        for (long long start = 0; start < m; start += kRoundsPerBlock) {
+            const size_t n = static_cast<size_t>(std::min(kRoundsPerBlock, m - start));
+            fillBlock<GameT, Mode, Policy>(rng, second_chance_prob, n, m_skip_inert_bg, items, block);
 
-            // UPDATE 7: Track max multipliers
-            if (result.max_bg_multiplier > m_max_bg_multiplier) m_max_bg_multiplier = result.max_bg_multiplier;
-            if (result.max_fg_multiplier > m_max_fg_multiplier) m_max_fg_multiplier = result.max_fg_multiplier;
+            for (size_t j = 0; j < block.size; ++j) {
+                double total_score = block.bg_score[j] + block.fg_score[j];
 
-            // UPDATE 8: Track levels statistics
-            // Category 1: BG levels
-            m_total_bg_levels += result.bg_levels;
-            if (result.bg_levels != 1) {
-                m_bg_nonzero_levels_sum += result.bg_levels;
-                m_bg_nonzero_levels_count++;
-            }
-            if (result.bg_levels > m_max_bg_level) {
-                m_max_bg_level = result.bg_levels;
-            }
+                // UPDATE 1-2: Batch statistics; merged into the overall ones after the loop
+                moments.total.update(total_score);
+                moments.bg.update(block.bg_score[j]);
 
-            // Category 2: FG picks
-            int run_max_fg_level = 0;
-            for (int fg_level : result.fg_levels) {
-                m_total_fg_levels += fg_level;
-                if (fg_level != 1) {
-                    m_fg_nonzero_levels_sum += fg_level;
-                    m_fg_nonzero_levels_count++;
-                }
-                if (fg_level > run_max_fg_level) run_max_fg_level = fg_level;
+                // UPDATE 3: BG/FG score contributions
+                moments.bg_score += block.bg_score[j];
+                moments.fg_score += block.fg_score[j];
             }
-            if (run_max_fg_level > m_max_fg_level) {
-                m_max_fg_level = run_max_fg_level;
-            }
-
-            // Category 3: Per run
-            long long run_total_levels = result.bg_levels;
-            long long run_nonzero_sum = (result.bg_levels != 1) ? result.bg_levels : 0;
-            long long run_nonzero_count = (result.bg_levels != 1) ? 1 : 0;
-            int run_max_level = result.bg_levels;
-
-            for (int fg_level : result.fg_levels) {
-                run_total_levels += fg_level;
-                if (fg_level != 1) {
-                    run_nonzero_sum += fg_level;
-                    run_nonzero_count++;
-                }
-                if (fg_level > run_max_level) run_max_level = fg_level;
-            }
-
-            m_total_run_levels += run_total_levels;
-            m_run_nonzero_levels_sum += run_nonzero_sum;
-            m_run_nonzero_levels_count += run_nonzero_count;
-            if (run_max_level > m_max_run_level) {
-                m_max_run_level = run_max_level;
-            }
-
-            // UPDATE 9: Histogram distribution tracking
-            if (total_score < 0) {
-                m_histogram.underflow++;
-            } else if (total_score >= m_histogram.dividers.back()) {
-                m_histogram.overflow++;
-            } else {
-                auto it = std::upper_bound(m_histogram.dividers.begin(), m_histogram.dividers.end(), total_score);
-                int bin_index = std::distance(m_histogram.dividers.begin(), it) - 1;
-                m_histogram.bins[bin_index]++;
+            // UPDATE 4: Counters, levels, top values and histogram
+            totals.template addBlock<Policy>(block, batch * m + start);
+
+            // Inert rounds skipped by the sampler: zero score, BG level 1, no FG.
+            if (block.inert_rounds > 0) {
+                const long long inert = static_cast<long long>(block.inert_rounds);
+                moments.total.updateRepeated(0.0, inert);
+                moments.bg.updateRepeated(0.0, inert);
+                totals.template addInert<Policy>(inert);
             }
         }
 
         // After completing all m rounds in this batch, store the batch mean
-        m_batch_means.push_back(batch_stats.M1);
+        m_batch_means.push_back(moments.total.M1);
+        if (items) item_merge.add(batch, std::move(batch_items));
 
         // Progress reporting by batch
         if ((batch + 1) % progress_interval_batches == 0) {
@@ -522,6 +756,9 @@ void MonteCarloSimulator::runEfficientMode_SingleThread(long long k, long long m
         }
     }
 
+    mergeChunkMoments(chunk_moments);
+    if (items) m_item_contributions.merge(item_merge.total());
+    storeTotals(totals);
     auto end_sim_time = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double> sim_elapsed = end_sim_time - start_sim_time;
     std::cout << "[Monitor] Simulation loop finished in " << sim_elapsed.count() << " seconds." << std::endl;
@@ -531,93 +768,46 @@ void MonteCarloSimulator::runEfficientMode_SingleThread(long long k, long long m
 
 
 // Fallback Implementation without CI
-void MonteCarloSimulator::runAccurateMode_SingleThread(long long numSimulations, Game::SimulationMode sim_mode, double second_chance_prob) {
+template <typename GameT, typename RngT>
+template <Game::SimulationMode Mode, Game::StatsPolicy Policy>
+void MonteCarloSimulator<GameT, RngT>::runAccurateMode_SingleThread(long long numSimulations, double second_chance_prob) {
     std::cout << "[Monitor] Starting simulation in ACCURATE memory mode." << std::endl;
     auto start_sim_time = std::chrono::high_resolution_clock::now();
     m_results.clear(); m_results.reserve(numSimulations);
     const long long progress_interval = numSimulations > 20 ? numSimulations / 20 : 1;
-
-    for (long long i = 0; i < numSimulations; ++i) {
-        Game::GameResult result = Game::simulateGameRound(m_rng, sim_mode, second_chance_prob);
-        double total_score = result.bg_score + result.fg_score;
-        m_results.push_back(total_score);
-
-        m_total_bg_score = m_total_bg_score.load() + result.bg_score;
-        m_total_fg_score = m_total_fg_score.load() + result.fg_score;
-
-        // Track nonzero frequencies
-        if (result.bg_score != 0) m_nonzero_bg_count++;
-        if (result.fg_score != 0) m_nonzero_fg_sessions_count++;  // Session-level tracking
-        if (total_score != 0) m_nonzero_total_count++;
-        m_nonzero_fg_picks_count += result.fg_nonzero_picks;  // Pick-level tracking
-
-        // Track FG statistics
-        if (result.fg_was_triggered) {
-            m_total_fg_picks += result.fg_run_length;
-            m_fg_triggered_count++;
-            if (result.fg_run_length > 0) {
-                m_total_fg_runs++;
-                if (result.fg_run_length > m_max_fg_length) {
-                    m_max_fg_length = result.fg_run_length;
+    const long long num_chunks = (numSimulations + kRoundsPerChunk - 1) / kRoundsPerChunk;
+    Accumulator totals;
+    Game::ChunkOrderedMerge<Game::ItemContributions> item_merge(num_chunks);  // Item counters of each chunk
+
+    Game::GameResultBlock block;
+    Game::ItemContributions chunk_items;
+    Game::ItemContributions* items = m_track_items ? &chunk_items : nullptr;
+    for (long long c = 0; c < num_chunks; ++c) {
+        RngT rng(m_run_seed, static_cast<uint64_t>(c));  // Stream of this chunk
+        if (items) chunk_items = GameT::makeItemContributions();
+        const long long chunk_end = std::min(numSimulations, (c + 1) * kRoundsPerChunk);
+        for (long long start = c * kRoundsPerChunk; start < chunk_end; start += kRoundsPerBlock) {
+            const size_t n = static_cast<size_t>(std::min(kRoundsPerBlock, chunk_end - start));
+            fillBlock<GameT, Mode, Policy>(rng, second_chance_prob, n, false, items, block);
+
+            for (size_t j = 0; j < n; ++j) {
+                const long long i = start + static_cast<long long>(j);
+                double total_score = block.bg_score[j] + block.fg_score[j];
+                m_results.push_back(total_score);
+
+                m_total_bg_score += block.bg_score[j];
+                m_total_fg_score += block.fg_score[j];
+
+                if ((i + 1) % progress_interval == 0) {
+                    std::cout << "          ... Progress: " << (100 * (i + 1) / numSimulations) << "% complete." << std::endl;
                 }
             }
+            totals.template addBlock<Policy>(block, start);
         }
-
-        // Track max multipliers
-        if (result.max_bg_multiplier > m_max_bg_multiplier) m_max_bg_multiplier = result.max_bg_multiplier;
-        if (result.max_fg_multiplier > m_max_fg_multiplier) m_max_fg_multiplier = result.max_fg_multiplier;
-
-        // Track levels statistics
-        // Category 1: BG levels
-        m_total_bg_levels += result.bg_levels;
-        if (result.bg_levels != 1) {
-            m_bg_nonzero_levels_sum += result.bg_levels;
-            m_bg_nonzero_levels_count++;
-        }
-        if (result.bg_levels > m_max_bg_level) {
-            m_max_bg_level = result.bg_levels;
-        }
-
-        // Category 2: FG picks
-        int run_max_fg_level = 0;
-        for (int fg_level : result.fg_levels) {
-            m_total_fg_levels += fg_level;
-            if (fg_level != 1) {
-                m_fg_nonzero_levels_sum += fg_level;
-                m_fg_nonzero_levels_count++;
-            }
-            if (fg_level > run_max_fg_level) run_max_fg_level = fg_level;
-        }
-        if (run_max_fg_level > m_max_fg_level) {
-            m_max_fg_level = run_max_fg_level;
-        }
-
-        // Category 3: Per run
-        long long run_total_levels = result.bg_levels;
-        long long run_nonzero_sum = (result.bg_levels != 1) ? result.bg_levels : 0;
-        long long run_nonzero_count = (result.bg_levels != 1) ? 1 : 0;
-        int run_max_level = result.bg_levels;
-
-        for (int fg_level : result.fg_levels) {
-            run_total_levels += fg_level;
-            if (fg_level != 1) {
-                run_nonzero_sum += fg_level;
-                run_nonzero_count++;
-            }
-            if (fg_level > run_max_level) run_max_level = fg_level;
-        }
-
-        m_total_run_levels += run_total_levels;
-        m_run_nonzero_levels_sum += run_nonzero_sum;
-        m_run_nonzero_levels_count += run_nonzero_count;
-        if (run_max_level > m_max_run_level) {
-            m_max_run_level = run_max_level;
-        }
-
-        if ((i + 1) % progress_interval == 0) {
-            std::cout << "          ... Progress: " << (100 * (i + 1) / numSimulations) << "% complete." << std::endl;
-        }
+        if (items) item_merge.add(c, std::move(chunk_items));
     }
+    if (items) m_item_contributions.merge(item_merge.total());
+    storeTotals(totals);
     auto end_sim_time = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double> sim_elapsed = end_sim_time - start_sim_time;
     std::cout << "[Monitor] Simulation loop finished in " << sim_elapsed.count() << " seconds." << std::endl;
@@ -626,7 +816,9 @@ void MonteCarloSimulator::runAccurateMode_SingleThread(long long numSimulations,
 
 
 // New implementation with bootstrapping for CI
-void MonteCarloSimulator::runAccurateMode_SingleThread(long long k, long long m, Game::SimulationMode sim_mode, double second_chance_prob) {
+template <typename GameT, typename RngT>
+template <Game::SimulationMode Mode, Game::StatsPolicy Policy>
+void MonteCarloSimulator<GameT, RngT>::runAccurateMode_SingleThread(long long k, long long m, double second_chance_prob) {
     std::cout << "[Monitor] Starting simulation in ACCURATE memory mode with batch-level structure." << std::endl;
     std::cout << "[Monitor] Configuration: " << k << " batches × " << m << " rounds/batch = " << (k * m) << " total rounds" << std::endl;
     auto start_sim_time = std::chrono::high_resolution_clock::now();
@@ -635,87 +827,32 @@ void MonteCarloSimulator::runAccurateMode_SingleThread(long long k, long long m,
     m_results.clear();
     m_results.reserve(numSimulations);
     const long long progress_interval_batches = k > 100 ? k / 100 : 1;
+    Accumulator totals;
+    Game::ChunkOrderedMerge<Game::ItemContributions> item_merge(k);  // Item counters of each batch
+
+    Game::GameResultBlock block;
+    Game::ItemContributions batch_items;
+    Game::ItemContributions* items = m_track_items ? &batch_items : nullptr;
 
     // BATCH-LEVEL LOOP: Process batches sequentially
     for (long long batch = 0; batch < k; ++batch) {
+        RngT rng(m_run_seed, static_cast<uint64_t>(batch));  // Stream of this batch
+        if (items) batch_items = GameT::makeItemContributions();
         // INNER LOOP: Process all rounds in this batch
-        for (long long round = 0; round < m; ++round) {
-            Game::GameResult result = Game::simulateGameRound(m_rng, sim_mode, second_chance_prob);
-            double total_score = result.bg_score + result.fg_score;
-            m_results.push_back(total_score);
+        for (long long start = 0; start < m; start += kRoundsPerBlock) {
+            const size_t n = static_cast<size_t>(std::min(kRoundsPerBlock, m - start));
+            fillBlock<GameT, Mode, Policy>(rng, second_chance_prob, n, false, items, block);
 
-            m_total_bg_score = m_total_bg_score.load() + result.bg_score;
-            m_total_fg_score = m_total_fg_score.load() + result.fg_score;
+            for (size_t j = 0; j < n; ++j) {
+                double total_score = block.bg_score[j] + block.fg_score[j];
+                m_results.push_back(total_score);
 
-            // Track nonzero frequencies
-            if (result.bg_score != 0) m_nonzero_bg_count++;
-            if (result.fg_score != 0) m_nonzero_fg_sessions_count++;  // Session-level tracking
-            if (total_score != 0) m_nonzero_total_count++;
-            m_nonzero_fg_picks_count += result.fg_nonzero_picks;  // Pick-level tracking
-
-            // Track FG statistics
-            if (result.fg_was_triggered) {
-                m_total_fg_picks += result.fg_run_length;
-                m_fg_triggered_count++;
-                if (result.fg_run_length > 0) {
-                    m_total_fg_runs++;
-                    if (result.fg_run_length > m_max_fg_length) {
-                        m_max_fg_length = result.fg_run_length;
-                    }
-                }
-            }
-
-            // Track max multipliers
-            if (result.max_bg_multiplier > m_max_bg_multiplier) m_max_bg_multiplier = result.max_bg_multiplier;
-            if (result.max_fg_multiplier > m_max_fg_multiplier) m_max_fg_multiplier = result.max_fg_multiplier;
-
-            // Track levels statistics
-            // Category 1: BG levels
-            m_total_bg_levels += result.bg_levels;
-            if (result.bg_levels != 1) {
-                m_bg_nonzero_levels_sum += result.bg_levels;
-                m_bg_nonzero_levels_count++;
-            }
-            if (result.bg_levels > m_max_bg_level) {
-                m_max_bg_level = result.bg_levels;
-            }
-
-            // Category 2: FG picks
-            int run_max_fg_level = 0;
-            for (int fg_level : result.fg_levels) {
-                m_total_fg_levels += fg_level;
-                if (fg_level != 1) {
-                    m_fg_nonzero_levels_sum += fg_level;
-                    m_fg_nonzero_levels_count++;
-                }
-                if (fg_level > run_max_fg_level) run_max_fg_level = fg_level;
-            }
-            if (run_max_fg_level > m_max_fg_level) {
-                m_max_fg_level = run_max_fg_level;
-            }
-
-            // Category 3: Per run
-            long long run_total_levels = result.bg_levels;
-            long long run_nonzero_sum = (result.bg_levels != 1) ? result.bg_levels : 0;
-            long long run_nonzero_count = (result.bg_levels != 1) ? 1 : 0;
-            int run_max_level = result.bg_levels;
-
-            for (int fg_level : result.fg_levels) {
-                run_total_levels += fg_level;
-                if (fg_level != 1) {
-                    run_nonzero_sum += fg_level;
-                    run_nonzero_count++;
-                }
-                if (fg_level > run_max_level) run_max_level = fg_level;
-            }
-
-            m_total_run_levels += run_total_levels;
-            m_run_nonzero_levels_sum += run_nonzero_sum;
-            m_run_nonzero_levels_count += run_nonzero_count;
-            if (run_max_level > m_max_run_level) {
-                m_max_run_level = run_max_level;
+                m_total_bg_score += block.bg_score[j];
+                m_total_fg_score += block.fg_score[j];
             }
+            totals.template addBlock<Policy>(block, batch * m + start);
         }
+        if (items) item_merge.add(batch, std::move(batch_items));
 
         // Progress reporting by batch
         if ((batch + 1) % progress_interval_batches == 0) {
@@ -725,6 +862,8 @@ void MonteCarloSimulator::runAccurateMode_SingleThread(long long k, long long m,
         }
     }
 
+    if (items) m_item_contributions.merge(item_merge.total());
+    storeTotals(totals);
     auto end_sim_time = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double> sim_elapsed = end_sim_time - start_sim_time;
     std::cout << "[Monitor] Simulation loop finished in " << sim_elapsed.count() << " seconds." << std::endl;
@@ -735,201 +874,77 @@ void MonteCarloSimulator::runAccurateMode_SingleThread(long long k, long long m,
 // --- Parallel Runners ---
 
 // Fallback Implementation without CI
-void MonteCarloSimulator::runEfficientMode_Parallel(long long numSimulations, Game::SimulationMode sim_mode, double second_chance_prob) {
+template <typename GameT, typename RngT>
+template <Game::SimulationMode Mode, Game::StatsPolicy Policy>
+void MonteCarloSimulator<GameT, RngT>::runEfficientMode_Parallel(long long numSimulations, double second_chance_prob) {
     std::cout << "[Monitor] Starting parallel simulation in EFFICIENT memory mode." << std::endl;
     auto start_sim_time = std::chrono::high_resolution_clock::now();
     int num_threads = 0;
-    std::vector<OnlineStats> thread_stats;
-    std::vector<OnlineStats> thread_bg_stats;  // BG-only stats per thread
-    std::vector<Histogram> thread_histograms;
-    std::vector<std::vector<double>> thread_top_values;
-    std::vector<long long> thread_max_fg_lengths;
-    std::vector<long long> thread_max_bg_multipliers;
-    std::vector<long long> thread_max_fg_multipliers;
-    std::vector<int> thread_max_bg_levels;
-    std::vector<int> thread_max_fg_levels;
-    std::vector<int> thread_max_run_levels;
-    long long total_fg_runs_p = 0;
-    long long total_fg_picks_p = 0;
-    long long fg_triggered_count_p = 0;
-    double total_bg_score_p = 0.0;
-    double total_fg_score_p = 0.0;
-    long long nonzero_bg_p = 0, nonzero_fg_sessions_p = 0, nonzero_fg_picks_p = 0, nonzero_total_p = 0;
-    long long total_bg_levels_p = 0, bg_nonzero_levels_sum_p = 0, bg_nonzero_levels_count_p = 0;
-    long long total_fg_levels_p = 0, fg_nonzero_levels_sum_p = 0, fg_nonzero_levels_count_p = 0;
-    long long total_run_levels_p = 0, run_nonzero_levels_sum_p = 0, run_nonzero_levels_count_p = 0;
-    std::atomic<long long> completed_count = 0;
-    const long long progress_interval = numSimulations > 20 ? numSimulations / 20 : 1;
-
+    Accumulator total(m_histogram.dividers);  // Merged from every thread as it finishes
+    Game::ProgressMonitor progress(numSimulations);
+    const long long num_chunks = (numSimulations + kRoundsPerChunk - 1) / kRoundsPerChunk;
+    std::vector<ChunkMoments> chunk_moments(num_chunks);  // Merged in chunk order after the loop
+    Game::ChunkOrderedMerge<Game::ItemContributions> item_merge(num_chunks);  // Item counters of each chunk, likewise
+
+    Game::ChunkScheduler scheduler;
+    Game::ChunkScheduler::checkChunkCount(num_chunks);
     #pragma omp parallel
     {
         #pragma omp master
         {
             num_threads = omp_get_num_threads();
+            scheduler.reset(num_chunks, num_threads);
+            progress.start(num_threads);
             std::cout << "[Monitor] Detected and using " << num_threads << " threads." << std::endl;
-            thread_stats.resize(num_threads);
-            thread_bg_stats.resize(num_threads);  // BG-only stats per thread
-            thread_histograms.resize(num_threads);
-            thread_top_values.resize(num_threads);
-            thread_max_fg_lengths.resize(num_threads, 0);
-            thread_max_bg_multipliers.resize(num_threads, 1);
-            thread_max_fg_multipliers.resize(num_threads, 1);
-            thread_max_bg_levels.resize(num_threads, 0);
-            thread_max_fg_levels.resize(num_threads, 0);
-            thread_max_run_levels.resize(num_threads, 0);
-            for(int i = 0; i < num_threads; ++i) {
-                thread_histograms[i].bins.assign(m_histogram.dividers.size() - 1, 0);
-            }
         }
         #pragma omp barrier
         int thread_id = omp_get_thread_num();
-        std::mt19937 local_rng(m_rng());
-
-        #pragma omp for reduction(+:total_fg_runs_p, total_fg_picks_p, fg_triggered_count_p, total_bg_score_p, total_fg_score_p, nonzero_bg_p, nonzero_fg_sessions_p, nonzero_fg_picks_p, nonzero_total_p, total_bg_levels_p, bg_nonzero_levels_sum_p, bg_nonzero_levels_count_p, total_fg_levels_p, fg_nonzero_levels_sum_p, fg_nonzero_levels_count_p, total_run_levels_p, run_nonzero_levels_sum_p, run_nonzero_levels_count_p) schedule(dynamic)
-        for (long long i = 0; i < numSimulations; ++i) {
-            Game::GameResult result = Game::simulateGameRound(local_rng, sim_mode, second_chance_prob);
-            double total_score = result.bg_score + result.fg_score;
-            thread_stats[thread_id].update(total_score);
-            thread_bg_stats[thread_id].update(result.bg_score);
-            updateTopValues(thread_top_values[thread_id], total_score, 5);
-
-            total_bg_score_p += result.bg_score;
-            total_fg_score_p += result.fg_score;
-
-            // Track nonzero frequencies
-            if (result.bg_score != 0) nonzero_bg_p++;
-            if (result.fg_score != 0) nonzero_fg_sessions_p++;  // Session-level tracking
-            if (total_score != 0) nonzero_total_p++;
-            nonzero_fg_picks_p += result.fg_nonzero_picks;  // Pick-level tracking
-
-            // Track FG statistics
-            if (result.fg_was_triggered) {
-                total_fg_picks_p += result.fg_run_length;
-                fg_triggered_count_p++;
-                if (result.fg_run_length > 0) {
-                    total_fg_runs_p++;
-                    if(result.fg_run_length > thread_max_fg_lengths[thread_id]) {
-                        thread_max_fg_lengths[thread_id] = result.fg_run_length;
-                    }
+        Accumulator acc(m_histogram.dividers);  // This thread's running statistics
+        Game::GameResultBlock block;
+        Game::ItemContributions chunk_items;
+        Game::ItemContributions* items = m_track_items ? &chunk_items : nullptr;
+
+        // Chunks come from this thread's share first, then from the fullest other share
+        long long c;
+        while (scheduler.next(thread_id, c)) {
+            RngT rng(m_run_seed, static_cast<uint64_t>(c));  // Stream of this chunk
+            ChunkMoments& moments = chunk_moments[c];
+            if (items) chunk_items = GameT::makeItemContributions();
+            const long long chunk_end = std::min(numSimulations, (c + 1) * kRoundsPerChunk);
+            for (long long start = c * kRoundsPerChunk; start < chunk_end; start += kRoundsPerBlock) {
+                const size_t n = static_cast<size_t>(std::min(kRoundsPerBlock, chunk_end - start));
+                fillBlock<GameT, Mode, Policy>(rng, second_chance_prob, n, m_skip_inert_bg, items, block);
+
+                for (size_t j = 0; j < block.size; ++j) {
+                    double total_score = block.bg_score[j] + block.fg_score[j];
+
+                    moments.total.update(total_score);
+                    moments.bg.update(block.bg_score[j]);
+                    moments.bg_score += block.bg_score[j];
+                    moments.fg_score += block.fg_score[j];
                 }
-            }
-
-            // Track max multipliers
-            if(result.max_bg_multiplier > thread_max_bg_multipliers[thread_id]) {
-                thread_max_bg_multipliers[thread_id] = result.max_bg_multiplier;
-            }
-            if(result.max_fg_multiplier > thread_max_fg_multipliers[thread_id]) {
-                thread_max_fg_multipliers[thread_id] = result.max_fg_multiplier;
-            }
-
-            // Track levels statistics
-            // Category 1: BG levels
-            total_bg_levels_p += result.bg_levels;
-            if (result.bg_levels != 1) {
-                bg_nonzero_levels_sum_p += result.bg_levels;
-                bg_nonzero_levels_count_p++;
-            }
-            if (result.bg_levels > thread_max_bg_levels[thread_id]) {
-                thread_max_bg_levels[thread_id] = result.bg_levels;
-            }
-
-            // Category 2: FG picks
-            int run_max_fg_level = 0;
-            for (int fg_level : result.fg_levels) {
-                total_fg_levels_p += fg_level;
-                if (fg_level != 1) {
-                    fg_nonzero_levels_sum_p += fg_level;
-                    fg_nonzero_levels_count_p++;
+                acc.template addBlock<Policy>(block, start);
+
+                // Inert rounds skipped by the sampler: zero score, BG level 1, no FG.
+                if (block.inert_rounds > 0) {
+                    const long long inert = static_cast<long long>(block.inert_rounds);
+                    moments.total.updateRepeated(0.0, inert);
+                    moments.bg.updateRepeated(0.0, inert);
+                    acc.template addInert<Policy>(inert);
                 }
-                if (fg_level > run_max_fg_level) run_max_fg_level = fg_level;
-            }
-            if (run_max_fg_level > thread_max_fg_levels[thread_id]) {
-                thread_max_fg_levels[thread_id] = run_max_fg_level;
-            }
-
-            // Category 3: Per run
-            long long run_total_levels = result.bg_levels;
-            long long run_nonzero_sum = (result.bg_levels != 1) ? result.bg_levels : 0;
-            long long run_nonzero_count = (result.bg_levels != 1) ? 1 : 0;
-            int run_max_level = result.bg_levels;
-
-            for (int fg_level : result.fg_levels) {
-                run_total_levels += fg_level;
-                if (fg_level != 1) {
-                    run_nonzero_sum += fg_level;
-                    run_nonzero_count++;
-                }
-                if (fg_level > run_max_level) run_max_level = fg_level;
-            }
-
-            total_run_levels_p += run_total_levels;
-            run_nonzero_levels_sum_p += run_nonzero_sum;
-            run_nonzero_levels_count_p += run_nonzero_count;
-            if (run_max_level > thread_max_run_levels[thread_id]) {
-                thread_max_run_levels[thread_id] = run_max_level;
-            }
-
-            if (total_score < 0) { thread_histograms[thread_id].underflow++; } 
-            else if (total_score >= m_histogram.dividers.back()) { thread_histograms[thread_id].overflow++; } 
-            else {
-                auto it = std::upper_bound(m_histogram.dividers.begin(), m_histogram.dividers.end(), total_score);
-                int bin_index = std::distance(m_histogram.dividers.begin(), it) - 1;
-                thread_histograms[thread_id].bins[bin_index]++;
-            }
-            
-            long long current_completed = completed_count.fetch_add(1, std::memory_order_relaxed) + 1;
-            if ((current_completed % progress_interval == 0) && (thread_id == 0)) {
-                #pragma omp critical
-                std::cout << "          ... Progress: " << (100 * current_completed / numSimulations) << "% complete." << std::endl;
             }
+            if (items) item_merge.add(c, std::move(chunk_items));
+            progress.add(thread_id, chunk_end - c * kRoundsPerChunk);
         }
+
+        #pragma omp critical
+        total.merge(acc);
     }
+    progress.stop();
     std::cout << "[Monitor] Combining results from all threads..." << std::endl;
-    m_fg_triggered_count = fg_triggered_count_p;
-    m_total_fg_runs = total_fg_runs_p;
-    m_total_fg_picks = total_fg_picks_p;
-    m_total_bg_score = total_bg_score_p;
-    m_total_fg_score = total_fg_score_p;
-    m_nonzero_bg_count = nonzero_bg_p;
-    m_nonzero_fg_sessions_count = nonzero_fg_sessions_p;
-    m_nonzero_fg_picks_count = nonzero_fg_picks_p;
-    m_nonzero_total_count = nonzero_total_p;
-    for(long long max_val : thread_max_fg_lengths) { if(max_val > m_max_fg_length) { m_max_fg_length = max_val; } }
-    for(long long max_val : thread_max_bg_multipliers) { if(max_val > m_max_bg_multiplier) { m_max_bg_multiplier = max_val; } }
-    for(long long max_val : thread_max_fg_multipliers) { if(max_val > m_max_fg_multiplier) { m_max_fg_multiplier = max_val; } }
-
-    // Aggregate levels statistics
-    m_total_bg_levels = total_bg_levels_p;
-    m_bg_nonzero_levels_sum = bg_nonzero_levels_sum_p;
-    m_bg_nonzero_levels_count = bg_nonzero_levels_count_p;
-    m_total_fg_levels = total_fg_levels_p;
-    m_fg_nonzero_levels_sum = fg_nonzero_levels_sum_p;
-    m_fg_nonzero_levels_count = fg_nonzero_levels_count_p;
-    m_total_run_levels = total_run_levels_p;
-    m_run_nonzero_levels_sum = run_nonzero_levels_sum_p;
-    m_run_nonzero_levels_count = run_nonzero_levels_count_p;
-    for(int max_val : thread_max_bg_levels) { if(max_val > m_max_bg_level) { m_max_bg_level = max_val; } }
-    for(int max_val : thread_max_fg_levels) { if(max_val > m_max_fg_level) { m_max_fg_level = max_val; } }
-    for(int max_val : thread_max_run_levels) { if(max_val > m_max_run_level) { m_max_run_level = max_val; } }
-
-    m_final_online_stats = thread_stats[0];
-    m_final_bg_online_stats = thread_bg_stats[0];  // BG-only stats
-    m_histogram.bins.assign(m_histogram.dividers.size() - 1, 0);
-    for (int i = 0; i < num_threads; ++i) {
-        if(i > 0) {
-            m_final_online_stats.combine(thread_stats[i]);
-            m_final_bg_online_stats.combine(thread_bg_stats[i]);  // Combine BG stats
-        }
-        for(size_t j = 0; j < m_histogram.bins.size(); ++j) { m_histogram.bins[j] += thread_histograms[i].bins[j]; }
-        m_histogram.underflow += thread_histograms[i].underflow;
-        m_histogram.overflow += thread_histograms[i].overflow;
-    }
-    m_top_values_tracker.clear();
-    for (const auto& vec : thread_top_values) {
-        m_top_values_tracker.insert(m_top_values_tracker.end(), vec.begin(), vec.end());
-    }
-    std::sort(m_top_values_tracker.rbegin(), m_top_values_tracker.rend());
-    m_top_values_tracker.resize(std::min((size_t)5, m_top_values_tracker.size()));
+    mergeChunkMoments(chunk_moments);
+    if (m_track_items) m_item_contributions.merge(item_merge.total());
+    storeTotals(total);
 
     auto end_sim_time = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double> sim_elapsed = end_sim_time - start_sim_time;
@@ -939,259 +954,95 @@ void MonteCarloSimulator::runEfficientMode_Parallel(long long numSimulations, Ga
 
 
 // New Efficient Mode with batch calculation of CI
-void MonteCarloSimulator::runEfficientMode_Parallel(long long k, long long m, Game::SimulationMode sim_mode, double second_chance_prob) {
+template <typename GameT, typename RngT>
+template <Game::SimulationMode Mode, Game::StatsPolicy Policy>
+void MonteCarloSimulator<GameT, RngT>::runEfficientMode_Parallel(long long k, long long m, double second_chance_prob) {
     std::cout << "[Monitor] Starting parallel simulation in EFFICIENT memory mode with batch-level parallelization." << std::endl;
     std::cout << "[Monitor] Configuration: " << k << " batches " << m << " rounds/batch = " << (k * m) << " total rounds" << std::endl;
     auto start_sim_time = std::chrono::high_resolution_clock::now();
 
     int num_threads = 0;
-    std::vector<OnlineStats> thread_stats;
-    std::vector<OnlineStats> thread_bg_stats;  // BG-only stats per thread
-    std::vector<std::vector<double>> thread_batch_means;
-    std::vector<Histogram> thread_histograms;
-    std::vector<std::vector<double>> thread_top_values;
-    std::vector<long long> thread_max_fg_lengths;
-    std::vector<long long> thread_max_bg_multipliers;
-    std::vector<long long> thread_max_fg_multipliers;
-    std::vector<int> thread_max_bg_levels;
-    std::vector<int> thread_max_fg_levels;
-    std::vector<int> thread_max_run_levels;
-    long long total_fg_runs_p = 0;
-    long long total_fg_picks_p = 0;
-    long long fg_triggered_count_p = 0;
-    double total_bg_score_p = 0.0;
-    double total_fg_score_p = 0.0;
-    long long nonzero_bg_p = 0, nonzero_fg_sessions_p = 0, nonzero_fg_picks_p = 0, nonzero_total_p = 0;
-    long long total_bg_levels_p = 0, bg_nonzero_levels_sum_p = 0, bg_nonzero_levels_count_p = 0;
-    long long total_fg_levels_p = 0, fg_nonzero_levels_sum_p = 0, fg_nonzero_levels_count_p = 0;
-    long long total_run_levels_p = 0, run_nonzero_levels_sum_p = 0, run_nonzero_levels_count_p = 0;
-    std::atomic<long long> completed_batch_count{0};
-    const long long progress_interval_batches = k > 100 ? k / 100 : 1;
+    std::vector<ChunkMoments> chunk_moments(k);  // One chunk per batch, merged in batch order after the loop
+    Game::ChunkOrderedMerge<Game::ItemContributions> item_merge(k);  // Item counters of each batch, likewise
+    Accumulator total(m_histogram.dividers);  // Merged from every thread as it finishes
+    Game::ProgressMonitor progress(k * m);
 
+    Game::ChunkScheduler scheduler;
+    Game::ChunkScheduler::checkChunkCount(k);
     #pragma omp parallel
     {
         #pragma omp master
         {
             num_threads = omp_get_num_threads();
+            scheduler.reset(k, num_threads);
+            progress.start(num_threads);
             std::cout << "[Monitor] Detected and using " << num_threads << " threads." << std::endl;
-            std::cout << "[Monitor] Using dynamic batch scheduling for optimal load balancing." << std::endl;
-            thread_stats.resize(num_threads);
-            thread_bg_stats.resize(num_threads);  // BG-only stats per thread
-            thread_batch_means.resize(num_threads);
-            thread_histograms.resize(num_threads);
-            thread_top_values.resize(num_threads);
-            thread_max_fg_lengths.resize(num_threads, 0);
-            thread_max_bg_multipliers.resize(num_threads, 1);
-            thread_max_fg_multipliers.resize(num_threads, 1);
-            thread_max_bg_levels.resize(num_threads, 0);
-            thread_max_fg_levels.resize(num_threads, 0);
-            thread_max_run_levels.resize(num_threads, 0);
-            for(int i = 0; i < num_threads; ++i) {
-                thread_histograms[i].bins.assign(m_histogram.dividers.size() - 1, 0);
-            }
+            std::cout << "[Monitor] Using work-stealing batch scheduling for load balancing." << std::endl;
         }
         #pragma omp barrier
         int thread_id = omp_get_thread_num();
-        std::mt19937 local_rng(m_rng());
+        Accumulator acc(m_histogram.dividers);  // This thread's running statistics
+        Game::GameResultBlock block;
+        Game::ItemContributions batch_items;
+        Game::ItemContributions* items = m_track_items ? &batch_items : nullptr;
 
         // BATCH-LEVEL PARALLELIZATION: Each thread processes complete batches
-        #pragma omp for reduction(+:total_fg_runs_p, total_fg_picks_p, fg_triggered_count_p, total_bg_score_p, total_fg_score_p, nonzero_bg_p, nonzero_fg_sessions_p, nonzero_fg_picks_p, nonzero_total_p, total_bg_levels_p, bg_nonzero_levels_sum_p, bg_nonzero_levels_count_p, total_fg_levels_p, fg_nonzero_levels_sum_p, fg_nonzero_levels_count_p, total_run_levels_p, run_nonzero_levels_sum_p, run_nonzero_levels_count_p) schedule(dynamic)
-        for (long long batch = 0; batch < k; ++batch) {
-            OnlineStats batch_stats; // Fresh statistics for this batch
+        // Batches come from this thread's share first, then from the fullest other share
+        long long batch;
+        while (scheduler.next(thread_id, batch)) {
+            RngT rng(m_run_seed, static_cast<uint64_t>(batch));  // Stream of this batch
+            ChunkMoments& moments = chunk_moments[batch];
+            if (items) batch_items = GameT::makeItemContributions();
 
             // INNER LOOP: Process all rounds in this batch
-            for (long long round = 0; round < m; ++round) {
-                Game::GameResult result = Game::simulateGameRound(local_rng, sim_mode, second_chance_prob);
-                double total_score = result.bg_score + result.fg_score;
-
-                // UPDATE 1: Overall statistics (for all rounds across all batches)
-                thread_stats[thread_id].update(total_score);
-                thread_bg_stats[thread_id].update(result.bg_score);
-
-                // UPDATE 2: Batch statistics (for this specific batch)
-                batch_stats.update(total_score);
-
-                // UPDATE 3: Top values tracking
-                updateTopValues(thread_top_values[thread_id], total_score, 5);
-
-                // UPDATE 4: BG/FG score contributions
-                total_bg_score_p += result.bg_score;
-                total_fg_score_p += result.fg_score;
-
-                // UPDATE 5: Track nonzero frequencies
-                if (result.bg_score != 0) nonzero_bg_p++;
-                if (result.fg_score != 0) nonzero_fg_sessions_p++;  // Session-level tracking
-                if (total_score != 0) nonzero_total_p++;
-                nonzero_fg_picks_p += result.fg_nonzero_picks;  // Pick-level tracking
-
-                // UPDATE 6: FG statistics (trigger count, run lengths)
-                if (result.fg_was_triggered) {
-                    total_fg_picks_p += result.fg_run_length;
-                    fg_triggered_count_p++;
-                    if (result.fg_run_length > 0) {
-                        total_fg_runs_p++;
-                        if(result.fg_run_length > thread_max_fg_lengths[thread_id]) {
-                            thread_max_fg_lengths[thread_id] = result.fg_run_length;
-                        }
-                    }
-                }
+            for (long long start = 0; start < m; start += kRoundsPerBlock) {
+                const size_t n = static_cast<size_t>(std::min(kRoundsPerBlock, m - start));
+                fillBlock<GameT, Mode, Policy>(rng, second_chance_prob, n, m_skip_inert_bg, items, block);
 
-                // UPDATE 7: Track max multipliers
-                if(result.max_bg_multiplier > thread_max_bg_multipliers[thread_id]) {
-                    thread_max_bg_multipliers[thread_id] = result.max_bg_multiplier;
-                }
-                if(result.max_fg_multiplier > thread_max_fg_multipliers[thread_id]) {
-                    thread_max_fg_multipliers[thread_id] = result.max_fg_multiplier;
-                }
+                for (size_t j = 0; j < block.size; ++j) {
+                    double total_score = block.bg_score[j] + block.fg_score[j];
 
-                // UPDATE 8: Track levels statistics
-                // Category 1: BG levels
-                total_bg_levels_p += result.bg_levels;
-                if (result.bg_levels != 1) {
-                    bg_nonzero_levels_sum_p += result.bg_levels;
-                    bg_nonzero_levels_count_p++;
-                }
-                if (result.bg_levels > thread_max_bg_levels[thread_id]) {
-                    thread_max_bg_levels[thread_id] = result.bg_levels;
-                }
-
-                // Category 2: FG picks
-                int run_max_fg_level = 0;
-                for (int fg_level : result.fg_levels) {
-                    total_fg_levels_p += fg_level;
-                    if (fg_level != 1) {
-                        fg_nonzero_levels_sum_p += fg_level;
-                        fg_nonzero_levels_count_p++;
-                    }
-                    if (fg_level > run_max_fg_level) run_max_fg_level = fg_level;
-                }
-                if (run_max_fg_level > thread_max_fg_levels[thread_id]) {
-                    thread_max_fg_levels[thread_id] = run_max_fg_level;
-                }
+                    // UPDATE 1-2: Batch statistics; merged into the overall ones after the loop
+                    moments.total.update(total_score);
+                    moments.bg.update(block.bg_score[j]);
 
-                // Category 3: Per run
-                long long run_total_levels = result.bg_levels;
-                long long run_nonzero_sum = (result.bg_levels != 1) ? result.bg_levels : 0;
-                long long run_nonzero_count = (result.bg_levels != 1) ? 1 : 0;
-                int run_max_level = result.bg_levels;
-
-                for (int fg_level : result.fg_levels) {
-                    run_total_levels += fg_level;
-                    if (fg_level != 1) {
-                        run_nonzero_sum += fg_level;
-                        run_nonzero_count++;
-                    }
-                    if (fg_level > run_max_level) run_max_level = fg_level;
+                    // UPDATE 3: BG/FG score contributions
+                    moments.bg_score += block.bg_score[j];
+                    moments.fg_score += block.fg_score[j];
                 }
-
-                total_run_levels_p += run_total_levels;
-                run_nonzero_levels_sum_p += run_nonzero_sum;
-                run_nonzero_levels_count_p += run_nonzero_count;
-                if (run_max_level > thread_max_run_levels[thread_id]) {
-                    thread_max_run_levels[thread_id] = run_max_level;
-                }
-
-                // UPDATE 9: Histogram distribution tracking
-                if (total_score < 0) {
-                    thread_histograms[thread_id].underflow++;
-                } else if (total_score >= m_histogram.dividers.back()) {
-                    thread_histograms[thread_id].overflow++;
-                } else {
-                    auto it = std::upper_bound(m_histogram.dividers.begin(), m_histogram.dividers.end(), total_score);
-                    int bin_index = std::distance(m_histogram.dividers.begin(), it) - 1;
-                    thread_histograms[thread_id].bins[bin_index]++;
+                // UPDATE 4: Counters, levels, top values and histogram
+                acc.template addBlock<Policy>(block, batch * m + start);
+
+                // Inert rounds skipped by the sampler: zero score, BG level 1, no FG.
+                if (block.inert_rounds > 0) {
+                    const long long inert = static_cast<long long>(block.inert_rounds);
+                    moments.total.updateRepeated(0.0, inert);
+                    moments.bg.updateRepeated(0.0, inert);
+                    acc.template addInert<Policy>(inert);
                 }
             }
+            if (items) item_merge.add(batch, std::move(batch_items));
 
-            // After completing all m rounds in this batch, store the batch mean
-            thread_batch_means[thread_id].push_back(batch_stats.M1);
-
-            // Progress reporting by batch
-            long long batches_completed = completed_batch_count.fetch_add(1, std::memory_order_relaxed) + 1;
-            if (batches_completed % progress_interval_batches == 0) {
-                #pragma omp critical
-                std::cout << "          ... Progress: Batch " << batches_completed << "/" << k
-                          << " (" << std::fixed << std::setprecision(1)
-                          << (100.0 * batches_completed / k) << "% complete)" << std::endl;
-            }
+            progress.add(thread_id, m);
         }
-    }
-
-    std::cout << "[Monitor] Combining results from all threads..." << std::endl;
 
-    // Combine FG statistics
-    m_fg_triggered_count = fg_triggered_count_p;
-    m_total_fg_runs = total_fg_runs_p;
-    m_total_fg_picks = total_fg_picks_p;
-    m_total_bg_score = total_bg_score_p;
-    m_total_fg_score = total_fg_score_p;
-    m_nonzero_bg_count = nonzero_bg_p;
-    m_nonzero_fg_sessions_count = nonzero_fg_sessions_p;
-    m_nonzero_fg_picks_count = nonzero_fg_picks_p;
-    m_nonzero_total_count = nonzero_total_p;
-    for(long long max_val : thread_max_fg_lengths) {
-        if(max_val > m_max_fg_length) {
-            m_max_fg_length = max_val;
-        }
-    }
-    for(long long max_val : thread_max_bg_multipliers) {
-        if(max_val > m_max_bg_multiplier) {
-            m_max_bg_multiplier = max_val;
-        }
-    }
-    for(long long max_val : thread_max_fg_multipliers) {
-        if(max_val > m_max_fg_multiplier) {
-            m_max_fg_multiplier = max_val;
-        }
+        #pragma omp critical
+        total.merge(acc);
     }
+    progress.stop();
 
-    // Aggregate levels statistics
-    m_total_bg_levels = total_bg_levels_p;
-    m_bg_nonzero_levels_sum = bg_nonzero_levels_sum_p;
-    m_bg_nonzero_levels_count = bg_nonzero_levels_count_p;
-    m_total_fg_levels = total_fg_levels_p;
-    m_fg_nonzero_levels_sum = fg_nonzero_levels_sum_p;
-    m_fg_nonzero_levels_count = fg_nonzero_levels_count_p;
-    m_total_run_levels = total_run_levels_p;
-    m_run_nonzero_levels_sum = run_nonzero_levels_sum_p;
-    m_run_nonzero_levels_count = run_nonzero_levels_count_p;
-    for(int max_val : thread_max_bg_levels) { if(max_val > m_max_bg_level) { m_max_bg_level = max_val; } }
-    for(int max_val : thread_max_fg_levels) { if(max_val > m_max_fg_level) { m_max_fg_level = max_val; } }
-    for(int max_val : thread_max_run_levels) { if(max_val > m_max_run_level) { m_max_run_level = max_val; } }
-
-    // Combine overall statistics
-    m_final_online_stats = thread_stats[0];
-    m_final_bg_online_stats = thread_bg_stats[0];  // BG-only stats
-    for (int i = 1; i < num_threads; ++i) {
-        m_final_online_stats.combine(thread_stats[i]);
-        m_final_bg_online_stats.combine(thread_bg_stats[i]);  // Combine BG stats
-    }
+    std::cout << "[Monitor] Combining results from all threads..." << std::endl;
 
-    // Combine batch means
+    // Combine overall statistics, item counters and batch means in batch order
+    mergeChunkMoments(chunk_moments);
+    if (m_track_items) m_item_contributions.merge(item_merge.total());
     m_batch_means.clear();
-    for (int i = 0; i < num_threads; ++i) {
-        m_batch_means.insert(m_batch_means.end(), thread_batch_means[i].begin(), thread_batch_means[i].end());
+    for (const ChunkMoments& batch : chunk_moments) {
+        m_batch_means.push_back(batch.total.M1);
     }
 
-    // Combine histograms
-    m_histogram.bins.assign(m_histogram.dividers.size() - 1, 0);
-    m_histogram.underflow = 0;
-    m_histogram.overflow = 0;
-    for (int i = 0; i < num_threads; ++i) {
-        for(size_t j = 0; j < m_histogram.bins.size(); ++j) {
-            m_histogram.bins[j] += thread_histograms[i].bins[j];
-        }
-        m_histogram.underflow += thread_histograms[i].underflow;
-        m_histogram.overflow += thread_histograms[i].overflow;
-    }
-
-    // Combine and sort top values
-    m_top_values_tracker.clear();
-    for (const auto& vec : thread_top_values) {
-        m_top_values_tracker.insert(m_top_values_tracker.end(), vec.begin(), vec.end());
-    }
-    std::sort(m_top_values_tracker.rbegin(), m_top_values_tracker.rend());
-    m_top_values_tracker.resize(std::min((size_t)5, m_top_values_tracker.size()));
+    // Counters, histogram and top values merged from the threads
+    storeTotals(total);
 
     auto end_sim_time = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double> sim_elapsed = end_sim_time - start_sim_time;
@@ -1201,173 +1052,71 @@ void MonteCarloSimulator::runEfficientMode_Parallel(long long k, long long m, Ga
 
 
 // Fallback Implementation without CI
-void MonteCarloSimulator::runAccurateMode_Parallel(long long numSimulations, Game::SimulationMode sim_mode, double second_chance_prob) {
+template <typename GameT, typename RngT>
+template <Game::SimulationMode Mode, Game::StatsPolicy Policy>
+void MonteCarloSimulator<GameT, RngT>::runAccurateMode_Parallel(long long numSimulations, double second_chance_prob) {
     std::cout << "[Monitor] Starting parallel simulation in ACCURATE memory mode." << std::endl;
     auto start_sim_time = std::chrono::high_resolution_clock::now();
     m_results.assign(numSimulations, 0.0);
     std::vector<double> bg_scores(numSimulations, 0.0);
     std::vector<double> fg_scores(numSimulations, 0.0);
-    std::vector<long long> fg_run_lengths(numSimulations, 0);
-    std::vector<bool> fg_triggered(numSimulations, false);
-    std::vector<long long> fg_nonzero_picks(numSimulations, 0);
-    std::vector<long long> bg_multipliers(numSimulations, 1);
-    std::vector<long long> fg_multipliers(numSimulations, 1);
-
-    // Levels tracking - optimized storage (only essential per-round data)
-    std::vector<int> bg_levels(numSimulations, 0);
-    std::vector<long long> total_fg_levels_per_round(numSimulations, 0);
-    std::vector<long long> fg_nonzero_levels_count_per_round(numSimulations, 0);
-
-    // Thread-local max tracking (not per-round to save memory)
     int num_threads = 0;
-    std::vector<int> thread_max_bg_levels;
-    std::vector<int> thread_max_fg_levels;
-    std::vector<int> thread_max_run_levels;
+    Accumulator total;  // Merged from every thread as it finishes
 
-    std::atomic<long long> completed_count = 0;
-    const long long progress_interval = numSimulations > 20 ? numSimulations / 20 : 1;
+    Game::ProgressMonitor progress(numSimulations);
+    const long long num_chunks = (numSimulations + kRoundsPerChunk - 1) / kRoundsPerChunk;
+    Game::ChunkOrderedMerge<Game::ItemContributions> item_merge(num_chunks);  // Item counters of each chunk, merged in chunk order
 
+    Game::ChunkScheduler scheduler;
+    Game::ChunkScheduler::checkChunkCount(num_chunks);
     #pragma omp parallel
     {
-        std::mt19937 local_rng(m_rng());
+        Game::GameResultBlock block;
+        Game::ItemContributions chunk_items;
+        Game::ItemContributions* items = m_track_items ? &chunk_items : nullptr;
         #pragma omp master
         {
             num_threads = omp_get_num_threads();
+            scheduler.reset(num_chunks, num_threads);
+            progress.start(num_threads);
             std::cout << "[Monitor] Detected and using " << num_threads << " threads." << std::endl;
-            thread_max_bg_levels.resize(num_threads, 0);
-            thread_max_fg_levels.resize(num_threads, 0);
-            thread_max_run_levels.resize(num_threads, 0);
         }
         #pragma omp barrier
         int thread_id = omp_get_thread_num();
-
-        #pragma omp for schedule(dynamic)
-        for (long long i = 0; i < numSimulations; ++i) {
-            Game::GameResult result = Game::simulateGameRound(local_rng, sim_mode, second_chance_prob);
-            m_results[i] = result.bg_score + result.fg_score;
-            bg_scores[i] = result.bg_score;
-            fg_scores[i] = result.fg_score;
-            fg_run_lengths[i] = result.fg_run_length;
-            fg_triggered[i] = result.fg_was_triggered;
-            fg_nonzero_picks[i] = result.fg_nonzero_picks;
-            bg_multipliers[i] = result.max_bg_multiplier;
-            fg_multipliers[i] = result.max_fg_multiplier;
-
-            // Track levels statistics
-            bg_levels[i] = result.bg_levels;
-
-            // Update thread-local max for BG
-            if (result.bg_levels > thread_max_bg_levels[thread_id]) {
-                thread_max_bg_levels[thread_id] = result.bg_levels;
-            }
-
-            // Category 2: FG picks - compute per-round aggregates
-            int run_max_fg_level = 0;
-            long long run_total_fg_levels = 0;
-            long long run_fg_nonzero_count = 0;
-            for (int fg_level : result.fg_levels) {
-                run_total_fg_levels += fg_level;
-                if (fg_level != 1) run_fg_nonzero_count++;
-                if (fg_level > run_max_fg_level) run_max_fg_level = fg_level;
-            }
-            total_fg_levels_per_round[i] = run_total_fg_levels;
-            fg_nonzero_levels_count_per_round[i] = run_fg_nonzero_count;
-
-            // Update thread-local max for FG and Per Run
-            if (run_max_fg_level > thread_max_fg_levels[thread_id]) {
-                thread_max_fg_levels[thread_id] = run_max_fg_level;
-            }
-            int run_max_level = std::max(result.bg_levels, run_max_fg_level);
-            if (run_max_level > thread_max_run_levels[thread_id]) {
-                thread_max_run_levels[thread_id] = run_max_level;
-            }
-
-            long long current_completed = completed_count.fetch_add(1, std::memory_order_relaxed) + 1;
-            if (current_completed % progress_interval == 0) {
-                 #pragma omp critical
-                 std::cout << "          ... Progress: " << (100 * current_completed / numSimulations) << "% complete." << std::endl;
-            }
-        }
-    }
-
-    for (double score : bg_scores) { m_total_bg_score = m_total_bg_score.load() + score; }
-    for (double score : fg_scores) { m_total_fg_score = m_total_fg_score.load() + score; }
-
-    // Count total FG picks
-    for (long long length : fg_run_lengths) {
-        m_total_fg_picks += length;
-        if (length > 0) {
-            m_total_fg_runs++;
-            if (length > m_max_fg_length) {
-                m_max_fg_length = length;
+        Accumulator acc;  // This thread's counters and maxima
+
+        // Chunks come from this thread's share first, then from the fullest other share
+        long long c;
+        while (scheduler.next(thread_id, c)) {
+            RngT rng(m_run_seed, static_cast<uint64_t>(c));  // Stream of this chunk
+            if (items) chunk_items = GameT::makeItemContributions();
+            const long long chunk_end = std::min(numSimulations, (c + 1) * kRoundsPerChunk);
+            for (long long start = c * kRoundsPerChunk; start < chunk_end; start += kRoundsPerBlock) {
+                const size_t n = static_cast<size_t>(std::min(kRoundsPerBlock, chunk_end - start));
+                fillBlock<GameT, Mode, Policy>(rng, second_chance_prob, n, false, items, block);
+
+                for (size_t j = 0; j < n; ++j) {
+                    const long long i = start + static_cast<long long>(j);
+                    m_results[i] = block.bg_score[j] + block.fg_score[j];
+                    bg_scores[i] = block.bg_score[j];
+                    fg_scores[i] = block.fg_score[j];
+                }
+                acc.template addBlock<Policy>(block, start);
             }
+            if (items) item_merge.add(c, std::move(chunk_items));
+            progress.add(thread_id, chunk_end - c * kRoundsPerChunk);
         }
-    }
-
-    for (bool triggered : fg_triggered) {
-        if (triggered) {
-            m_fg_triggered_count++;
-        }
-    }
 
-    // Count nonzero frequencies
-    for (size_t i = 0; i < numSimulations; ++i) {
-        if (bg_scores[i] != 0) m_nonzero_bg_count++;
-        if (fg_scores[i] != 0) m_nonzero_fg_sessions_count++;  // Session-level tracking
-        if (m_results[i] != 0) m_nonzero_total_count++;
-        m_nonzero_fg_picks_count += fg_nonzero_picks[i];  // Pick-level tracking
+        #pragma omp critical
+        total.merge(acc);
     }
+    progress.stop();
 
-    // Aggregate max multipliers
-    for (long long val : bg_multipliers) { if (val > m_max_bg_multiplier) m_max_bg_multiplier = val; }
-    for (long long val : fg_multipliers) { if (val > m_max_fg_multiplier) m_max_fg_multiplier = val; }
-
-    // Aggregate levels statistics
-    // Category 1: BG levels
-    for (int level : bg_levels) {
-        m_total_bg_levels += level;
-        if (level != 1) {
-            m_bg_nonzero_levels_sum += level;
-            m_bg_nonzero_levels_count++;
-        }
-    }
-    // Aggregate thread-local max for BG
-    for (int max_val : thread_max_bg_levels) {
-        if (max_val > m_max_bg_level) m_max_bg_level = max_val;
-    }
-
-    // Category 2: FG picks
-    for (size_t i = 0; i < numSimulations; ++i) {
-        m_total_fg_levels += total_fg_levels_per_round[i];
-        m_fg_nonzero_levels_count += fg_nonzero_levels_count_per_round[i];
-    }
-    // Aggregate thread-local max for FG
-    for (int max_val : thread_max_fg_levels) {
-        if (max_val > m_max_fg_level) m_max_fg_level = max_val;
-    }
-    // Derive fg_nonzero_levels_sum: total - (count_of_ones × 1)
-    long long total_fg_picks_val = m_total_fg_picks.load();
-    long long fg_ones_sum = total_fg_picks_val - m_fg_nonzero_levels_count.load();
-    m_fg_nonzero_levels_sum = m_total_fg_levels.load() - fg_ones_sum;
-
-    // Category 3: Per run - derive from Categories 1 & 2
-    for (size_t i = 0; i < numSimulations; ++i) {
-        // Derive total run levels: bg_levels + total_fg_levels
-        long long run_total = bg_levels[i] + total_fg_levels_per_round[i];
-        m_total_run_levels += run_total;
-
-        // Derive run nonzero count: (bg != 1 ? 1 : 0) + fg_nonzero_count
-        long long run_nonzero_count = (bg_levels[i] != 1 ? 1 : 0) + fg_nonzero_levels_count_per_round[i];
-        m_run_nonzero_levels_count += run_nonzero_count;
-    }
-    // Aggregate thread-local max for Per Run
-    for (int max_val : thread_max_run_levels) {
-        if (max_val > m_max_run_level) m_max_run_level = max_val;
-    }
-    // Derive run_nonzero_levels_sum: total - (count_of_ones × 1)
-    long long total_items = m_stats.count + total_fg_picks_val;
-    long long run_ones_sum = total_items - m_run_nonzero_levels_count.load();
-    m_run_nonzero_levels_sum = m_total_run_levels.load() - run_ones_sum;
+    // Score sums in round order, as in the single-threaded run
+    for (double score : bg_scores) { m_total_bg_score += score; }
+    for (double score : fg_scores) { m_total_fg_score += score; }
+    if (m_track_items) m_item_contributions.merge(item_merge.total());
+    storeTotals(total);
 
     auto end_sim_time = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double> sim_elapsed = end_sim_time - start_sim_time;
@@ -1376,7 +1125,9 @@ void MonteCarloSimulator::runAccurateMode_Parallel(long long numSimulations, Gam
 }
 
 // New implementation with bootstrapping for CI
-void MonteCarloSimulator::runAccurateMode_Parallel(long long k, long long m, Game::SimulationMode sim_mode, double second_chance_prob) {
+template <typename GameT, typename RngT>
+template <Game::SimulationMode Mode, Game::StatsPolicy Policy>
+void MonteCarloSimulator<GameT, RngT>::runAccurateMode_Parallel(long long k, long long m, double second_chance_prob) {
     std::cout << "[Monitor] Starting parallel simulation in ACCURATE memory mode with batch-level parallelization." << std::endl;
     std::cout << "[Monitor] Configuration: " << k << " batches " << m << " rounds/batch = " << (k * m) << " total rounds" << std::endl;
     auto start_sim_time = std::chrono::high_resolution_clock::now();
@@ -1385,178 +1136,67 @@ void MonteCarloSimulator::runAccurateMode_Parallel(long long k, long long m, Gam
     m_results.assign(numSimulations, 0.0);
     std::vector<double> bg_scores(numSimulations, 0.0);
     std::vector<double> fg_scores(numSimulations, 0.0);
-    std::vector<long long> fg_run_lengths(numSimulations, 0);
-    std::vector<bool> fg_triggered(numSimulations, false);
-    std::vector<long long> fg_nonzero_picks(numSimulations, 0);
-    std::vector<long long> bg_multipliers(numSimulations, 1);
-    std::vector<long long> fg_multipliers(numSimulations, 1);
-
-    // Levels tracking - optimized storage (only essential per-round data)
-    std::vector<int> bg_levels(numSimulations, 0);
-    std::vector<long long> total_fg_levels_per_round(numSimulations, 0);
-    std::vector<long long> fg_nonzero_levels_count_per_round(numSimulations, 0);
-
-    // Thread-local max tracking (not per-round to save memory)
     int num_threads = 0;
-    std::vector<int> thread_max_bg_levels;
-    std::vector<int> thread_max_fg_levels;
-    std::vector<int> thread_max_run_levels;
+    Accumulator total;  // Merged from every thread as it finishes
 
-    std::atomic<long long> completed_batch_count{0};
-    const long long progress_interval_batches = k > 100 ? k / 100 : 1;
+    Game::ProgressMonitor progress(k * m);
+    Game::ChunkOrderedMerge<Game::ItemContributions> item_merge(k);  // Item counters of each batch, merged in batch order
 
+    Game::ChunkScheduler scheduler;
+    Game::ChunkScheduler::checkChunkCount(k);
     #pragma omp parallel
     {
-        std::mt19937 local_rng(m_rng());
+        Game::GameResultBlock block;
+        Game::ItemContributions batch_items;
+        Game::ItemContributions* items = m_track_items ? &batch_items : nullptr;
         #pragma omp master
         {
             num_threads = omp_get_num_threads();
+            scheduler.reset(k, num_threads);
+            progress.start(num_threads);
             std::cout << "[Monitor] Detected and using " << num_threads << " threads." << std::endl;
-            std::cout << "[Monitor] Using dynamic batch scheduling for optimal load balancing." << std::endl;
-            thread_max_bg_levels.resize(num_threads, 0);
-            thread_max_fg_levels.resize(num_threads, 0);
-            thread_max_run_levels.resize(num_threads, 0);
+            std::cout << "[Monitor] Using work-stealing batch scheduling for load balancing." << std::endl;
         }
         #pragma omp barrier
         int thread_id = omp_get_thread_num();
+        Accumulator acc;  // This thread's counters and maxima
 
         // BATCH-LEVEL PARALLELIZATION: Each thread processes complete batches
-        #pragma omp for schedule(dynamic)
-        for (long long batch = 0; batch < k; ++batch) {
+        // Batches come from this thread's share first, then from the fullest other share
+        long long batch;
+        while (scheduler.next(thread_id, batch)) {
+            RngT rng(m_run_seed, static_cast<uint64_t>(batch));  // Stream of this batch
+            if (items) batch_items = GameT::makeItemContributions();
             // INNER LOOP: Process all rounds in this batch
-            for (long long round = 0; round < m; ++round) {
-                long long idx = batch * m + round; // Calculate global index
-
-                Game::GameResult result = Game::simulateGameRound(local_rng, sim_mode, second_chance_prob);
-                m_results[idx] = result.bg_score + result.fg_score;
-                bg_scores[idx] = result.bg_score;
-                fg_scores[idx] = result.fg_score;
-                fg_run_lengths[idx] = result.fg_run_length;
-                fg_triggered[idx] = result.fg_was_triggered;
-                fg_nonzero_picks[idx] = result.fg_nonzero_picks;
-                bg_multipliers[idx] = result.max_bg_multiplier;
-                fg_multipliers[idx] = result.max_fg_multiplier;
-
-                // Track levels statistics
-                bg_levels[idx] = result.bg_levels;
-
-                // Update thread-local max for BG
-                if (result.bg_levels > thread_max_bg_levels[thread_id]) {
-                    thread_max_bg_levels[thread_id] = result.bg_levels;
-                }
+            for (long long start = 0; start < m; start += kRoundsPerBlock) {
+                const size_t n = static_cast<size_t>(std::min(kRoundsPerBlock, m - start));
+                fillBlock<GameT, Mode, Policy>(rng, second_chance_prob, n, false, items, block);
 
-                // Category 2: FG picks - compute per-round aggregates
-                int run_max_fg_level = 0;
-                long long run_total_fg_levels = 0;
-                long long run_fg_nonzero_count = 0;
-                for (int fg_level : result.fg_levels) {
-                    run_total_fg_levels += fg_level;
-                    if (fg_level != 1) run_fg_nonzero_count++;
-                    if (fg_level > run_max_fg_level) run_max_fg_level = fg_level;
-                }
-                total_fg_levels_per_round[idx] = run_total_fg_levels;
-                fg_nonzero_levels_count_per_round[idx] = run_fg_nonzero_count;
+                for (size_t j = 0; j < n; ++j) {
+                    long long idx = batch * m + start + static_cast<long long>(j); // Calculate global index
 
-                // Update thread-local max for FG and Per Run
-                if (run_max_fg_level > thread_max_fg_levels[thread_id]) {
-                    thread_max_fg_levels[thread_id] = run_max_fg_level;
-                }
-                int run_max_level = std::max(result.bg_levels, run_max_fg_level);
-                if (run_max_level > thread_max_run_levels[thread_id]) {
-                    thread_max_run_levels[thread_id] = run_max_level;
+                    m_results[idx] = block.bg_score[j] + block.fg_score[j];
+                    bg_scores[idx] = block.bg_score[j];
+                    fg_scores[idx] = block.fg_score[j];
                 }
+                acc.template addBlock<Policy>(block, batch * m + start);
             }
+            if (items) item_merge.add(batch, std::move(batch_items));
 
-            // Progress reporting by batch
-            long long batches_completed = completed_batch_count.fetch_add(1, std::memory_order_relaxed) + 1;
-            if (batches_completed % progress_interval_batches == 0) {
-                #pragma omp critical
-                std::cout << "          ... Progress: Batch " << batches_completed << "/" << k
-                          << " (" << std::fixed << std::setprecision(1)
-                          << (100.0 * batches_completed / k) << "% complete)" << std::endl;
-            }
+            progress.add(thread_id, m);
         }
-    }
 
-    // Aggregate statistics from individual results
-    for (double score : bg_scores) { m_total_bg_score = m_total_bg_score.load() + score; }
-    for (double score : fg_scores) { m_total_fg_score = m_total_fg_score.load() + score; }
-
-    // Count total FG picks
-    for (long long length : fg_run_lengths) {
-        m_total_fg_picks += length;
-        if (length > 0) {
-            m_total_fg_runs++;
-            if (length > m_max_fg_length) {
-                m_max_fg_length = length;
-            }
-        }
-    }
-
-    for (bool triggered : fg_triggered) {
-        if (triggered) {
-            m_fg_triggered_count++;
-        }
-    }
-
-    // Count nonzero frequencies
-    for (size_t i = 0; i < numSimulations; ++i) {
-        if (bg_scores[i] != 0) m_nonzero_bg_count++;
-        if (fg_scores[i] != 0) m_nonzero_fg_sessions_count++;  // Session-level tracking
-        if (m_results[i] != 0) m_nonzero_total_count++;
-        m_nonzero_fg_picks_count += fg_nonzero_picks[i];  // Pick-level tracking
-    }
-
-    // Aggregate max multipliers
-    for (long long val : bg_multipliers) { if (val > m_max_bg_multiplier) m_max_bg_multiplier = val; }
-    for (long long val : fg_multipliers) { if (val > m_max_fg_multiplier) m_max_fg_multiplier = val; }
-
-    // Aggregate levels statistics
-    // Category 1: BG levels
-    for (int level : bg_levels) {
-        m_total_bg_levels += level;
-        if (level != 1) {
-            m_bg_nonzero_levels_sum += level;
-            m_bg_nonzero_levels_count++;
-        }
-    }
-    // Aggregate thread-local max for BG
-    for (int max_val : thread_max_bg_levels) {
-        if (max_val > m_max_bg_level) m_max_bg_level = max_val;
+        #pragma omp critical
+        total.merge(acc);
     }
+    progress.stop();
 
-    // Category 2: FG picks
-    for (size_t i = 0; i < numSimulations; ++i) {
-        m_total_fg_levels += total_fg_levels_per_round[i];
-        m_fg_nonzero_levels_count += fg_nonzero_levels_count_per_round[i];
-    }
-    // Aggregate thread-local max for FG
-    for (int max_val : thread_max_fg_levels) {
-        if (max_val > m_max_fg_level) m_max_fg_level = max_val;
-    }
-    // Derive fg_nonzero_levels_sum: total - (count_of_ones × 1)
-    long long total_fg_picks_val = m_total_fg_picks.load();
-    long long fg_ones_sum = total_fg_picks_val - m_fg_nonzero_levels_count.load();
-    m_fg_nonzero_levels_sum = m_total_fg_levels.load() - fg_ones_sum;
-
-    // Category 3: Per run - derive from Categories 1 & 2
-    for (size_t i = 0; i < numSimulations; ++i) {
-        // Derive total run levels: bg_levels + total_fg_levels
-        long long run_total = bg_levels[i] + total_fg_levels_per_round[i];
-        m_total_run_levels += run_total;
-
-        // Derive run nonzero count: (bg != 1 ? 1 : 0) + fg_nonzero_count
-        long long run_nonzero_count = (bg_levels[i] != 1 ? 1 : 0) + fg_nonzero_levels_count_per_round[i];
-        m_run_nonzero_levels_count += run_nonzero_count;
-    }
-    // Aggregate thread-local max for Per Run
-    for (int max_val : thread_max_run_levels) {
-        if (max_val > m_max_run_level) m_max_run_level = max_val;
-    }
-    // Derive run_nonzero_levels_sum: total - (count_of_ones × 1)
-    long long total_items = m_stats.count + total_fg_picks_val;
-    long long run_ones_sum = total_items - m_run_nonzero_levels_count.load();
-    m_run_nonzero_levels_sum = m_total_run_levels.load() - run_ones_sum;
+    // Aggregate statistics from individual results
+    // Score sums in round order, as in the single-threaded run
+    for (double score : bg_scores) { m_total_bg_score += score; }
+    for (double score : fg_scores) { m_total_fg_score += score; }
+    if (m_track_items) m_item_contributions.merge(item_merge.total());
+    storeTotals(total);
 
     auto end_sim_time = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double> sim_elapsed = end_sim_time - start_sim_time;
@@ -1566,7 +1206,8 @@ void MonteCarloSimulator::runAccurateMode_Parallel(long long k, long long m, Gam
 
 
 
-void MonteCarloSimulator::analyzeEfficientResults() {
+template <typename GameT, typename RngT>
+void MonteCarloSimulator<GameT, RngT>::analyzeEfficientResults() {
     std::cout << "\n[Monitor] Starting detailed analysis from online statistics..." << std::endl;
     auto start_analysis_time = std::chrono::high_resolution_clock::now();
     m_stats.count = m_final_online_stats.count;
@@ -1584,6 +1225,7 @@ void MonteCarloSimulator::analyzeEfficientResults() {
     m_stats.p95 = getPercentileFromHistogram(95.0);
     m_stats.p99 = getPercentileFromHistogram(99.0);
     m_stats.top_values = m_top_values_tracker;
+    std::sort(m_stats.top_values.rbegin(), m_stats.top_values.rend(), ranksBelow);
     std::cout << "Done." << std::endl;
     auto end_analysis_time = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double> analysis_elapsed = end_analysis_time - start_analysis_time;
@@ -1591,7 +1233,8 @@ void MonteCarloSimulator::analyzeEfficientResults() {
 }
 
 // --- HIGHLIGHT: New analysis function for Efficient Mode CI ---
-void MonteCarloSimulator::analyzeEfficientResults(long long k) {
+template <typename GameT, typename RngT>
+void MonteCarloSimulator<GameT, RngT>::analyzeEfficientResults(long long k) {
     // ... (unchanged analysis of overall mean, variance, etc. from m_final_online_stats) ...
     std::cout << "\n[Monitor] Starting detailed analysis from online statistics..." << std::endl;
     auto start_analysis_time = std::chrono::high_resolution_clock::now();
@@ -1610,6 +1253,7 @@ void MonteCarloSimulator::analyzeEfficientResults(long long k) {
     m_stats.p95 = getPercentileFromHistogram(95.0);
     m_stats.p99 = getPercentileFromHistogram(99.0);
     m_stats.top_values = m_top_values_tracker;
+    std::sort(m_stats.top_values.rbegin(), m_stats.top_values.rend(), ranksBelow);
     std::cout << "Done." << std::endl;
 
     // --- Validate batch count and calculate CI using Method of Batched Means ---
@@ -1646,7 +1290,8 @@ void MonteCarloSimulator::analyzeEfficientResults(long long k) {
     std::cout << "[Monitor] Full analysis complete in " << analysis_elapsed.count() << " seconds." << std::endl;
 }
 
-void MonteCarloSimulator::analyzeAccurateResults() {
+template <typename GameT, typename RngT>
+void MonteCarloSimulator<GameT, RngT>::analyzeAccurateResults() {
     std::cout << "\n[Monitor] Starting detailed analysis from stored data..." << std::endl;
     if (m_results.empty()) { std::cerr << "Analysis failed: No results to analyze." << std::endl; return; }
     auto start_analysis_time = std::chrono::high_resolution_clock::now();
@@ -1656,6 +1301,11 @@ void MonteCarloSimulator::analyzeAccurateResults() {
     m_stats.stdDev = Statistics::calculateStdDev(m_stats.variance);
     std::cout << "[Analysis] Calculating Skewness... "; m_stats.skewness = Statistics::calculateSkewness(m_results, m_stats.mean, m_stats.stdDev); std::cout << "Done." << std::endl;
     std::cout << "[Analysis] Calculating Kurtosis... "; m_stats.kurtosis = Statistics::calculateKurtosis(m_results, m_stats.mean, m_stats.stdDev); std::cout << "Done." << std::endl;
+    std::cout << "[Analysis] Extracting top values... ";
+    m_stats.top_values.clear();  // Before sorting, while m_results[i] is still round i
+    for (size_t i = 0; i < m_results.size(); ++i) { updateTopValues(m_stats.top_values, m_results[i], static_cast<long long>(i), 5); }
+    std::sort(m_stats.top_values.rbegin(), m_stats.top_values.rend(), ranksBelow);
+    std::cout << "Done." << std::endl;
     std::cout << "[Analysis] Sorting " << m_stats.count << " results for percentile and binning calculations..." << std::endl;
     auto sort_start = std::chrono::high_resolution_clock::now();
     std::sort(m_results.begin(), m_results.end());
@@ -1665,10 +1315,6 @@ void MonteCarloSimulator::analyzeAccurateResults() {
     m_stats.p95 = Statistics::findValueAtPercentile(m_results, 95.0);
     m_stats.p99 = Statistics::findValueAtPercentile(m_results, 99.0);
     std::cout << "Done." << std::endl;
-    std::cout << "[Analysis] Extracting top values... ";
-    m_stats.top_values.clear();
-    for(size_t i = 0; i < 5 && i < m_results.size(); ++i) { m_stats.top_values.push_back(m_results[m_results.size() - 1 - i]); }
-    std::cout << "Done." << std::endl;
     std::cout << "[Analysis] Grouping results into histogram bins... ";
     m_histogram.bins.assign(m_histogram.dividers.size() - 1, 0);
     m_histogram.underflow = 0;
@@ -1689,7 +1335,8 @@ void MonteCarloSimulator::analyzeAccurateResults() {
 }
 
 // --- Accurate mode analysis now includes parallel bootstrapping ---
-void MonteCarloSimulator::analyzeAccurateResults(long long k, long long m) {
+template <typename GameT, typename RngT>
+void MonteCarloSimulator<GameT, RngT>::analyzeAccurateResults(long long k, long long m) {
     // ... (unchanged analysis of overall mean, variance, etc. for m_results) ...
     std::cout << "\n[Monitor] Starting detailed analysis from stored data..." << std::endl;
     if (m_results.empty()) { std::cerr << "Analysis failed: No results to analyze." << std::endl; return; }
@@ -1700,6 +1347,11 @@ void MonteCarloSimulator::analyzeAccurateResults(long long k, long long m) {
     m_stats.stdDev = Statistics::calculateStdDev(m_stats.variance);
     std::cout << "[Analysis] Calculating Skewness... "; m_stats.skewness = Statistics::calculateSkewness(m_results, m_stats.mean, m_stats.stdDev); std::cout << "Done." << std::endl;
     std::cout << "[Analysis] Calculating Kurtosis... "; m_stats.kurtosis = Statistics::calculateKurtosis(m_results, m_stats.mean, m_stats.stdDev); std::cout << "Done." << std::endl;
+    std::cout << "[Analysis] Extracting top values... ";
+    m_stats.top_values.clear();  // Before sorting, while m_results[i] is still round i
+    for (size_t i = 0; i < m_results.size(); ++i) { updateTopValues(m_stats.top_values, m_results[i], static_cast<long long>(i), 5); }
+    std::sort(m_stats.top_values.rbegin(), m_stats.top_values.rend(), ranksBelow);
+    std::cout << "Done." << std::endl;
     std::cout << "[Analysis] Sorting " << m_stats.count << " results for percentile and binning calculations..." << std::endl;
     auto sort_start = std::chrono::high_resolution_clock::now();
     std::sort(m_results.begin(), m_results.end());
@@ -1709,10 +1361,6 @@ void MonteCarloSimulator::analyzeAccurateResults(long long k, long long m) {
     m_stats.p95 = Statistics::findValueAtPercentile(m_results, 95.0);
     m_stats.p99 = Statistics::findValueAtPercentile(m_results, 99.0);
     std::cout << "Done." << std::endl;
-    std::cout << "[Analysis] Extracting top values... ";
-    m_stats.top_values.clear();
-    for(size_t i = 0; i < 5 && i < m_results.size(); ++i) { m_stats.top_values.push_back(m_results[m_results.size() - 1 - i]); }
-    std::cout << "Done." << std::endl;
     std::cout << "[Analysis] Grouping results into histogram bins... ";
     m_histogram.bins.assign(m_histogram.dividers.size() - 1, 0);
     m_histogram.underflow = 0;
@@ -1735,15 +1383,13 @@ void MonteCarloSimulator::analyzeAccurateResults(long long k, long long m) {
 
     #pragma omp parallel
     {
-        std::mt19937 local_rng(m_rng()); // Each thread gets its own RNG
-        std::uniform_int_distribution<long long> dist(0, m_results.size() - 1);
-
         #pragma omp for
         for (long long i = 0; i < k; ++i) {
+            RngT local_rng(m_run_seed, kBootstrapStreamBase + static_cast<uint64_t>(i)); // Each sample has its own stream
             double current_sum = 0.0;
             for (long long j = 0; j < m; ++j) {
                 // Draw a random index with replacement
-                long long random_index = dist(local_rng);
+                const uint64_t random_index = Game::uniformIndex(local_rng, m_results.size());
                 current_sum += m_results[random_index];
             }
             m_bootstrap_means[i] = current_sum / m;
@@ -1766,7 +1412,8 @@ void MonteCarloSimulator::analyzeAccurateResults(long long k, long long m) {
     std::cout << "[Monitor] Full analysis complete in " << analysis_elapsed.count() << " seconds." << std::endl;
 }
 
-double MonteCarloSimulator::getPercentileFromHistogram(double percentile) const {
+template <typename GameT, typename RngT>
+double MonteCarloSimulator<GameT, RngT>::getPercentileFromHistogram(double percentile) const {
     if (m_stats.count == 0) return 0.0;
     long long target_count = m_stats.count * (percentile / 100.0);
     long long current_count = m_histogram.underflow;
@@ -1782,7 +1429,53 @@ double MonteCarloSimulator::getPercentileFromHistogram(double percentile) const
     return m_histogram.dividers.back();
 }
 
-void MonteCarloSimulator::printResults(int base_bet) const {
+// Prints one table of the item contribution report, ranked by payout.
+static void printContributionTable(const char* title, const std::vector<long long>& picks, const std::vector<double>& payout,
+                                   std::string (*describe)(int32_t), long long rounds, double total_payout,
+                                   int base_bet, size_t max_rows) {
+    std::vector<size_t> order;
+    for (size_t i = 0; i < picks.size(); ++i) {
+        if (picks[i] > 0) order.push_back(i);
+    }
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return payout[a] > payout[b]; });
+    const size_t shown = std::min(order.size(), max_rows);
+
+    std::cout << "\n" << title << " (top " << shown << " of " << order.size() << " picked, by payout)" << std::endl;
+    std::cout << std::right << std::setw(5) << "Rank" << std::setw(8) << "Entry" << std::setw(16) << "Picks"
+              << std::setw(14) << "Picks/Round" << std::setw(14) << "Avg Pay" << std::setw(12) << "RTP %"
+              << std::setw(12) << "Share %" << "  Description" << std::endl;
+    for (size_t r = 0; r < shown; ++r) {
+        const size_t i = order[r];
+        const double per_round = static_cast<double>(picks[i]) / rounds;
+        const double avg_pay = payout[i] / picks[i];
+        const double rtp = payout[i] / rounds / base_bet * 100;
+        const double share = (total_payout != 0.0) ? 100.0 * payout[i] / total_payout : 0.0;
+        std::cout << std::right << std::setw(5) << r + 1 << std::setw(8) << i << std::setw(16) << picks[i]
+                  << std::fixed << std::setprecision(6) << std::setw(14) << per_round
+                  << std::setprecision(4) << std::setw(14) << avg_pay << std::setw(12) << rtp << std::setw(12) << share
+                  << "  " << describe(static_cast<int32_t>(i)) << std::endl;
+    }
+}
+
+template <typename GameT, typename RngT>
+void MonteCarloSimulator<GameT, RngT>::printItemContributions(int base_bet) const {
+    const Game::ItemContributions& items = m_item_contributions;
+    if (m_stats.count == 0) return;
+    double total_payout = 0.0;
+    for (double v : items.bg_payout) total_payout += v;
+    for (double v : items.fg_payout) total_payout += v;
+
+    std::cout << "\n------ Item RTP Contribution ------" << std::endl;
+    std::cout << "RTP % is payout per round over the base bet; Share % is the item's part of all payout." << std::endl;
+    std::cout << "BG entries are outcome classes; rows with identical BG outcomes are pooled." << std::endl;
+    printContributionTable("BG Outcome Classes", items.bg_picks, items.bg_payout, GameT::describeBGClass,
+                           m_stats.count, total_payout, base_bet, m_item_report_rows);
+    printContributionTable("FG Rows", items.fg_picks, items.fg_payout, GameT::describeFGRow,
+                           m_stats.count, total_payout, base_bet, m_item_report_rows);
+}
+
+template <typename GameT, typename RngT>
+void MonteCarloSimulator<GameT, RngT>::printResults(int base_bet) const {
     std::cout << "\n------ Monte Carlo Simulation Results ------" << std::endl;
     std::cout << std::fixed << std::setprecision(6);
     std::cout << "Simulations Run:   " << m_stats.count << std::endl;
@@ -1799,17 +1492,51 @@ void MonteCarloSimulator::printResults(int base_bet) const {
     if(!m_stats.top_values.empty()){
         std::cout << "\nTop 5 Largest Values:" << std::endl;
         for(size_t i = 0; i < m_stats.top_values.size(); ++i) {
-            std::cout << "  " << i+1 << ". " << m_stats.top_values[i] << std::endl;
+            std::cout << "  " << i+1 << ". " << m_stats.top_values[i].value
+                      << "  (round " << m_stats.top_values[i].round << ")" << std::endl;
+        }
+        if (m_layout.replayable()) {
+            std::cout << "  (replayRound(round) re-simulates a listed round and prints its picks)" << std::endl;
         }
     }
-    
+
+    if (m_sim_mode == Game::SimulationMode::FG_ONLY && GameT::fgOnlyStartsAtBGEntry()) {
+        // Each round was one FG session started as FULL_GAME rounds enter FG, so
+        // the mean above is E[FG | entered] and scales by the entry probability.
+        const double p = m_fg_entry_probability;
+        const double std_error = m_stats.count > 0 ? m_stats.stdDev / std::sqrt(static_cast<double>(m_stats.count)) : 0.0;
+        std::cout << "\n------ FG_ONLY Conditional Session Estimate ------" << std::endl;
+        std::cout << "FG Entry Probability:   " << std::fixed << std::setprecision(8) << p << " (per FULL_GAME round)" << std::endl;
+        std::cout << "E[FG | entered]:        " << std::setprecision(6) << m_stats.mean << " ± " << std_error << " (1 s.e.)" << std::endl;
+        std::cout << "FULL_GAME FG per Round: " << p * m_stats.mean << " ± " << p * std_error
+                  << " (RTP " << std::setprecision(4) << p * m_stats.mean / base_bet * 100 << "%)" << std::endl;
+    }
+
+    if (m_two_phase.valid) {
+        const TwoPhaseEstimate& e = m_two_phase;
+        const double z95 = 1.959964;
+        std::cout << "\n------ Two-Phase FULL_GAME Estimate ------" << std::endl;
+        std::cout << std::fixed << std::setprecision(6);
+        std::cout << "BG_ONLY Pass:           " << e.bg_mean << " ± " << e.bg_std_error << " (" << e.bg_rounds << " rounds)" << std::endl;
+        std::cout << "FG_ONLY Pass:           " << e.fg_mean << " ± " << e.fg_std_error << " per session (" << e.fg_sessions << " sessions)" << std::endl;
+        std::cout << "FG Entry Probability:   " << std::setprecision(8) << e.fg_entry_probability << std::endl;
+        std::cout << "Mean (BG + p × FG):     " << std::setprecision(6) << e.mean << " ± " << e.std_error << " (1 s.e.)" << std::endl;
+        std::cout << "95% CI:                 [" << e.mean - z95 * e.std_error << ", " << e.mean + z95 * e.std_error << "]" << std::endl;
+        std::cout << "RTP:                    " << std::setprecision(4) << e.mean / base_bet * 100 << "% ± "
+                  << z95 * e.std_error / base_bet * 100 << "% (95%)" << std::endl;
+    }
+
+    // Sections whose counters the selected StatsPolicy did not collect are skipped.
+    const bool run_stats = m_stats_policy != Game::StatsPolicy::MINIMAL;
+    const bool level_stats = m_stats_policy == Game::StatsPolicy::FULL;
+
     std::cout << "\n------ Score Contribution Analysis ------" << std::endl;
-    double avg_bg_contrib = (m_stats.count > 0) ? m_total_bg_score.load() / m_stats.count : 0.0;
-    double avg_fg_contrib = (m_stats.count > 0) ? m_total_fg_score.load() / m_stats.count : 0.0;
-    long long total_fg_picks = m_total_fg_picks.load();
-    long long total_runs_with_fg = m_total_fg_runs.load();
+    double avg_bg_contrib = (m_stats.count > 0) ? m_total_bg_score / m_stats.count : 0.0;
+    double avg_fg_contrib = (m_stats.count > 0) ? m_total_fg_score / m_stats.count : 0.0;
+    long long total_fg_picks = m_totals.total_fg_picks;
+    long long total_runs_with_fg = m_totals.total_fg_runs;
     double avg_length = (total_runs_with_fg > 0) ? static_cast<double>(total_fg_picks) / total_runs_with_fg : 0.0;
-    long long fg_triggers = m_fg_triggered_count.load();
+    long long fg_triggers = m_totals.fg_triggered_count;
     double trigger_rate = (m_stats.count > 0) ? 100.0 * static_cast<double>(fg_triggers) / m_stats.count : 0.0;
     std::cout << "Avg. BG Score Contribution: " << avg_bg_contrib << std::endl;
     std::cout << "BG Standard Deviation: " << std::fixed << std::setprecision(6) << m_stats.bg_stdDev << std::endl;
@@ -1818,25 +1545,51 @@ void MonteCarloSimulator::printResults(int base_bet) const {
     std::cout << "BG RTP Contribution %: " << std::fixed << std::setprecision(4) << avg_bg_contrib/(avg_bg_contrib+avg_fg_contrib)*100 << "% "  << std::endl;
     std::cout << "Avg. FG Score Contribution: " << avg_fg_contrib << std::endl;
     std::cout << "Avg. FG RTP: " << std::fixed << std::setprecision(4) << avg_fg_contrib/(base_bet)*100 << "% " << std::endl;
-    std::cout << "Avg. Raw Per Round FG RTP: " << std::fixed << std::setprecision(4) << avg_fg_contrib/(base_bet)/avg_length/trigger_rate*10000 << "% " << std::endl;
+    if (run_stats) {
+        std::cout << "Avg. Raw Per Round FG RTP: " << std::fixed << std::setprecision(4) << avg_fg_contrib/(base_bet)/avg_length/trigger_rate*10000 << "% " << std::endl;
+    }
     std::cout << "FG RTP Contribution %: " << std::fixed << std::setprecision(4) << avg_fg_contrib/(avg_bg_contrib+avg_fg_contrib)*100 << "% "  << std::endl;
 
-    std::cout << "\n------ FG Trigger and Run Length Statistics ------" << std::endl;
-
-    std::cout << "FG Triggered Count:   " << fg_triggers << " (" << std::fixed << std::setprecision(4) << trigger_rate << "% of rounds)" << std::endl;
-
-    std::cout << "Total FG Picks:       " << total_fg_picks << " (across all FG sessions)" << std::endl;
-
-    std::cout << "Avg. FG Run Length:   " << std::fixed << std::setprecision(4) << avg_length << " (for sessions with FG)" << std::endl;
-    std::cout << "Max FG Run Length:    " << m_max_fg_length.load() << std::endl;
+    if (run_stats) {
+        std::cout << "\n------ FG Trigger and Run Length Statistics ------" << std::endl;
+
+        std::cout << "FG Triggered Count:   " << fg_triggers << " (" << std::fixed << std::setprecision(4) << trigger_rate << "% of rounds)" << std::endl;
+
+        std::cout << "Total FG Picks:       " << total_fg_picks << " (across all FG sessions)" << std::endl;
+
+        std::cout << "Avg. FG Run Length:   " << std::fixed << std::setprecision(4) << avg_length << " (for sessions with FG)" << std::endl;
+        std::cout << "Max FG Run Length:    " << m_totals.max_fg_length << std::endl;
+
+        // Each game caps runaway retrigger chains with its own limit and rule.
+        // Where the cap ends the session, a capped session loses every pick it
+        // still owes; otherwise the cap only drops the picks of retriggers that
+        // find too many owed, and the session plays out the rest. The RTP
+        // estimate prices each dropped pick at the observed mean FG pick value; it
+        // ignores any retriggers those picks would have produced, so it is a floor.
+        long long capped_sessions = m_totals.fg_capped_sessions;
+        long long dropped_picks = m_totals.fg_dropped_picks;
+        double capped_rate = (fg_triggers > 0) ? 100.0 * static_cast<double>(capped_sessions) / fg_triggers : 0.0;
+        double avg_pick_value = (total_fg_picks > 0) ? m_total_fg_score / total_fg_picks : 0.0;
+        double capped_rtp = (m_stats.count > 0) ? dropped_picks * avg_pick_value / m_stats.count / base_bet * 100 : 0.0;
+        if constexpr (GameT::fg_cap_ends_session) {
+            std::cout << "FG Cap Hits:          " << capped_sessions << " (" << std::fixed << std::setprecision(6) << capped_rate << "% of FG sessions ended by the cap)" << std::endl;
+            std::cout << "Dropped FG Picks:     " << dropped_picks << " (owed when those sessions ended)" << std::endl;
+        } else {
+            std::cout << "FG Cap Hits:          " << capped_sessions << " (" << std::fixed << std::setprecision(6) << capped_rate << "% of FG sessions with a retrigger dropped by the cap)" << std::endl;
+            std::cout << "Dropped FG Picks:     " << dropped_picks << " (granted by the dropped retriggers)" << std::endl;
+        }
+        std::cout << "Est. RTP Lost to Cap: " << std::fixed << std::setprecision(6) << capped_rtp << "% (dropped picks at mean FG pick value)" << std::endl;
 
-    std::cout << "\n------ Maximum Multipliers Observed ------" << std::endl;
-    std::cout << "Max BG Multiplier:    " << m_max_bg_multiplier.load() << std::endl;
-    std::cout << "Max FG Multiplier:    " << m_max_fg_multiplier.load() << std::endl;
+        std::cout << "\n------ Maximum Multipliers Observed ------" << std::endl;
+        std::cout << "Max BG Multiplier:    " << m_totals.max_bg_multiplier << std::endl;
+        std::cout << "Max FG Multiplier:    " << m_totals.max_fg_multiplier << std::endl;
+    } else {
+        std::cout << "\n[Info] FG run-length and multiplier statistics not collected (StatsPolicy::MINIMAL)." << std::endl;
+    }
 
     std::cout << "\n------ Nonzero Value Frequencies ------" << std::endl;
-    long long nonzero_bg = m_nonzero_bg_count.load();
-    long long nonzero_total = m_nonzero_total_count.load();
+    long long nonzero_bg = m_totals.nonzero_bg;
+    long long nonzero_total = m_totals.nonzero_total;
 
     double bg_nonzero_rate = (m_stats.count > 0) ? 100.0 * static_cast<double>(nonzero_bg) / m_stats.count : 0.0;
     double total_nonzero_rate = (m_stats.count > 0) ? 100.0 * static_cast<double>(nonzero_total) / m_stats.count : 0.0;
@@ -1844,61 +1597,71 @@ void MonteCarloSimulator::printResults(int base_bet) const {
     std::cout << "BG Nonzero:    " << nonzero_bg << " / " << m_stats.count << " rounds (" << std::fixed << std::setprecision(4) << bg_nonzero_rate << "%)" << std::endl;
     std::cout << "Total Nonzero: " << nonzero_total << " / " << m_stats.count << " rounds (" << std::fixed << std::setprecision(4) << total_nonzero_rate << "%)" << std::endl;
 
-    // --- FG Nonzero Frequencies (Dual-Level Tracking) ---
-    // Session-level: Tracks how many FG sessions had non-zero total payout
-    // Pick-level: Tracks how many individual FG picks had non-zero value
-    std::cout << "\nFG Nonzero (Session-Level):" << std::endl;
-    std::cout << "  Measures: Of all FG sessions, how many had non-zero total payout" << std::endl;
-    long long nonzero_fg_sessions = m_nonzero_fg_sessions_count.load();
-    double fg_sessions_nonzero_rate = (fg_triggers > 0) ? 100.0 * static_cast<double>(nonzero_fg_sessions) / fg_triggers : 0.0;
-    std::cout << "  Count:    " << nonzero_fg_sessions << " / " << fg_triggers << " FG sessions (" << std::fixed << std::setprecision(4) << fg_sessions_nonzero_rate << "%)" << std::endl;
-
-    std::cout << "\nFG Nonzero (Pick-Level):" << std::endl;
-    std::cout << "  Measures: Of all individual FG picks, how many had non-zero value" << std::endl;
-    std::cout << "  Note:     Should match the FG item configuration from input data" << std::endl;
-    long long nonzero_fg_picks = m_nonzero_fg_picks_count.load();
-    double fg_picks_nonzero_rate = (total_fg_picks > 0) ? 100.0 * static_cast<double>(nonzero_fg_picks) / total_fg_picks : 0.0;
-    std::cout << "  Count:    " << nonzero_fg_picks << " / " << total_fg_picks << " FG picks (" << std::fixed << std::setprecision(4) << fg_picks_nonzero_rate << "%)" << std::endl;
-
-    // --- New section for Levels Statistics ---
-    std::cout << "\n------ Levels Statistics ------" << std::endl;
-    std::cout << "  Note: These statistics track the 'levels' field from configuration data" << std::endl;
-    std::cout << "        Items with value=0 have levels=1 by data integrity constraint" << std::endl;
-    std::cout << "        'Nonzero Value' means items where level != 1 (i.e., value != 0)" << std::endl;
-
-    // Category 1: BG Items
-    std::cout << "\nCategory 1: BG Items (per-item statistics)" << std::endl;
-    std::cout << "  Denominator: " << m_stats.count << " BG items (total rounds)" << std::endl;
-    std::cout << "  Max BG Level:                  " << m_max_bg_level.load() << std::endl;
-    double bg_avg_total = (m_stats.count > 0) ? static_cast<double>(m_total_bg_levels.load()) / m_stats.count : 0.0;
-    std::cout << "  Avg BG Level (Total):          " << std::fixed << std::setprecision(4) << bg_avg_total << std::endl;
-    long long bg_nonzero_count = m_bg_nonzero_levels_count.load();
-    double bg_avg_nonzero = (bg_nonzero_count > 0) ? static_cast<double>(m_bg_nonzero_levels_sum.load()) / bg_nonzero_count : 0.0;
-    std::cout << "  Avg BG Level (Nonzero Value):  " << std::fixed << std::setprecision(4) << bg_avg_nonzero << std::endl;
-    std::cout << "  Note: Should match BG config baseline from JSON loading" << std::endl;
-
-    // Category 2: FG Picks
-    std::cout << "\nCategory 2: FG Picks (per-item statistics)" << std::endl;
-    std::cout << "  Denominator: " << total_fg_picks << " FG picks (total items picked)" << std::endl;
-    std::cout << "  Max FG Level:                  " << m_max_fg_level.load() << std::endl;
-    double fg_avg_total = (total_fg_picks > 0) ? static_cast<double>(m_total_fg_levels.load()) / total_fg_picks : 0.0;
-    std::cout << "  Avg FG Level (Total):          " << std::fixed << std::setprecision(4) << fg_avg_total << std::endl;
-    long long fg_nonzero_count = m_fg_nonzero_levels_count.load();
-    double fg_avg_nonzero = (fg_nonzero_count > 0) ? static_cast<double>(m_fg_nonzero_levels_sum.load()) / fg_nonzero_count : 0.0;
-    std::cout << "  Avg FG Level (Nonzero Value):  " << std::fixed << std::setprecision(4) << fg_avg_nonzero << std::endl;
-    std::cout << "  Note: Should match FG config baseline from JSON loading" << std::endl;
-
-    // Category 3: Per Run
-    std::cout << "\nCategory 3: Per Run (combined BG + FG statistics)" << std::endl;
-    long long total_items = m_stats.count + total_fg_picks;
-    std::cout << "  Denominator: " << total_items << " total items (BG + FG)" << std::endl;
-    std::cout << "  Max Run Level:                 " << m_max_run_level.load() << std::endl;
-    double run_avg_total = (total_items > 0) ? static_cast<double>(m_total_run_levels.load()) / total_items : 0.0;
-    std::cout << "  Avg Run Level (Total):         " << std::fixed << std::setprecision(4) << run_avg_total << std::endl;
-    long long run_nonzero_count = m_run_nonzero_levels_count.load();
-    double run_avg_nonzero = (run_nonzero_count > 0) ? static_cast<double>(m_run_nonzero_levels_sum.load()) / run_nonzero_count : 0.0;
-    std::cout << "  Avg Run Level (Nonzero Value): " << std::fixed << std::setprecision(4) << run_avg_nonzero << std::endl;
-    std::cout << "  Note: Overview of levels when BG and FG are combined" << std::endl;
+    if (run_stats) {
+        // --- FG Nonzero Frequencies (Dual-Level Tracking) ---
+        // Session-level: Tracks how many FG sessions had non-zero total payout
+        // Pick-level: Tracks how many individual FG picks had non-zero value
+        std::cout << "\nFG Nonzero (Session-Level):" << std::endl;
+        std::cout << "  Measures: Of all FG sessions, how many had non-zero total payout" << std::endl;
+        long long nonzero_fg_sessions = m_totals.nonzero_fg_sessions;
+        double fg_sessions_nonzero_rate = (fg_triggers > 0) ? 100.0 * static_cast<double>(nonzero_fg_sessions) / fg_triggers : 0.0;
+        std::cout << "  Count:    " << nonzero_fg_sessions << " / " << fg_triggers << " FG sessions (" << std::fixed << std::setprecision(4) << fg_sessions_nonzero_rate << "%)" << std::endl;
+
+        std::cout << "\nFG Nonzero (Pick-Level):" << std::endl;
+        std::cout << "  Measures: Of all individual FG picks, how many had non-zero value" << std::endl;
+        std::cout << "  Note:     Should match the FG item configuration from input data" << std::endl;
+        long long nonzero_fg_picks = m_totals.nonzero_fg_picks;
+        double fg_picks_nonzero_rate = (total_fg_picks > 0) ? 100.0 * static_cast<double>(nonzero_fg_picks) / total_fg_picks : 0.0;
+        std::cout << "  Count:    " << nonzero_fg_picks << " / " << total_fg_picks << " FG picks (" << std::fixed << std::setprecision(4) << fg_picks_nonzero_rate << "%)" << std::endl;
+    }
+
+    if (level_stats) {
+        // --- New section for Levels Statistics ---
+        std::cout << "\n------ Levels Statistics ------" << std::endl;
+        std::cout << "  Note: These statistics track the 'levels' field from configuration data" << std::endl;
+        std::cout << "        Items with value=0 have levels=1 by data integrity constraint" << std::endl;
+        std::cout << "        'Nonzero Value' means items where level != 1 (i.e., value != 0)" << std::endl;
+
+        // Category 1: BG Items
+        std::cout << "\nCategory 1: BG Items (per-item statistics)" << std::endl;
+        std::cout << "  Denominator: " << m_stats.count << " BG items (total rounds)" << std::endl;
+        std::cout << "  Max BG Level:                  " << m_totals.max_bg_level << std::endl;
+        double bg_avg_total = (m_stats.count > 0) ? static_cast<double>(m_totals.total_bg_levels) / m_stats.count : 0.0;
+        std::cout << "  Avg BG Level (Total):          " << std::fixed << std::setprecision(4) << bg_avg_total << std::endl;
+        long long bg_nonzero_count = m_totals.bg_nonzero_levels_count;
+        double bg_avg_nonzero = (bg_nonzero_count > 0) ? static_cast<double>(m_totals.bg_nonzero_levels_sum) / bg_nonzero_count : 0.0;
+        std::cout << "  Avg BG Level (Nonzero Value):  " << std::fixed << std::setprecision(4) << bg_avg_nonzero << std::endl;
+        std::cout << "  Note: Should match BG config baseline from JSON loading" << std::endl;
+
+        // Category 2: FG Picks
+        std::cout << "\nCategory 2: FG Picks (per-item statistics)" << std::endl;
+        std::cout << "  Denominator: " << total_fg_picks << " FG picks (total items picked)" << std::endl;
+        std::cout << "  Max FG Level:                  " << m_totals.max_fg_level << std::endl;
+        double fg_avg_total = (total_fg_picks > 0) ? static_cast<double>(m_totals.total_fg_levels) / total_fg_picks : 0.0;
+        std::cout << "  Avg FG Level (Total):          " << std::fixed << std::setprecision(4) << fg_avg_total << std::endl;
+        long long fg_nonzero_count = m_totals.fg_nonzero_levels_count;
+        double fg_avg_nonzero = (fg_nonzero_count > 0) ? static_cast<double>(m_totals.fg_nonzero_levels_sum) / fg_nonzero_count : 0.0;
+        std::cout << "  Avg FG Level (Nonzero Value):  " << std::fixed << std::setprecision(4) << fg_avg_nonzero << std::endl;
+        std::cout << "  Note: Should match FG config baseline from JSON loading" << std::endl;
+
+        // Category 3: Per Run
+        std::cout << "\nCategory 3: Per Run (combined BG + FG statistics)" << std::endl;
+        long long total_items = m_stats.count + total_fg_picks;
+        std::cout << "  Denominator: " << total_items << " total items (BG + FG)" << std::endl;
+        std::cout << "  Max Run Level:                 " << m_totals.max_run_level << std::endl;
+        double run_avg_total = (total_items > 0) ? static_cast<double>(m_totals.total_run_levels) / total_items : 0.0;
+        std::cout << "  Avg Run Level (Total):         " << std::fixed << std::setprecision(4) << run_avg_total << std::endl;
+        long long run_nonzero_count = m_totals.run_nonzero_levels_count;
+        double run_avg_nonzero = (run_nonzero_count > 0) ? static_cast<double>(m_totals.run_nonzero_levels_sum) / run_nonzero_count : 0.0;
+        std::cout << "  Avg Run Level (Nonzero Value): " << std::fixed << std::setprecision(4) << run_avg_nonzero << std::endl;
+        std::cout << "  Note: Overview of levels when BG and FG are combined" << std::endl;
+    } else {
+        std::cout << "\n[Info] Levels statistics not collected (StatsPolicy is not FULL)." << std::endl;
+    }
+
+    if (m_track_items) {
+        printItemContributions(base_bet);
+    }
 
     // --- New section to print confidence intervals ---
     if (!m_stats.confidence_intervals.empty()) {
@@ -1961,4 +1724,11 @@ void MonteCarloSimulator::printResults(int base_bet) const {
     }
     
     std::cout << "-----------------------------------------------" << std::endl;
-}
\ No newline at end of file
+}
+
+// One simulator per registered game (see GameModule.h) and generator (see Rng.h).
+#define INSTANTIATE_SIMULATORS(Rng) \
+    template class MonteCarloSimulator<Game::SS03Module, Game::Rng>; \
+    template class MonteCarloSimulator<Game::DeepDiveModule, Game::Rng>;
+GAME_REGISTERED_RNGS(INSTANTIATE_SIMULATORS)
+#undef INSTANTIATE_SIMULATORS
@@ -2,10 +2,10 @@
 #define MONTE_CARLO_SIMULATOR_H
 
 #include <vector>
-#include <random>
 #include <string>
-#include <atomic> // For thread-safe stats
-#include "GameModule.h" // Automatically includes the correct game module
+#include "AlignedColumn.h"
+#include "GameTypes.h"
+#include "Rng.h"
 
 enum class MemoryMode {
     EFFICIENT, 
@@ -17,6 +17,7 @@ struct OnlineStats {
     long long count = 0;
     double M1 = 0.0, M2 = 0.0, M3 = 0.0, M4 = 0.0;
     void update(double value);
+    void updateRepeated(double value, long long n); // Same as n calls to update(value)
     void combine(const OnlineStats& other);
 };
 
@@ -27,6 +28,74 @@ struct ConfidenceInterval {
     double upper_bound;
 };
 
+// An entry of the top-k tracker: a round's total score and its global index
+// in the run (batch * m + offset in the batch). Rows of an inert BG skip-ahead
+// block keep the index of the round they stand for.
+struct TopRound {
+    double value;
+    long long round;
+};
+
+// Counts of round totals: bins[i] holds totals in [dividers[i], dividers[i + 1]).
+struct ScoreHistogram {
+    std::vector<double> dividers;
+    std::vector<long long> bins;
+    long long underflow = 0;
+    long long overflow = 0;
+};
+
+// The per-round bookkeeping every MonteCarloSimulator runner shares:
+// counters, maxima, and in EFFICIENT mode the histogram and top-k list
+// (ACCURATE mode keeps every score and derives those from it). It does not
+// depend on the game or generator; addBlock and addInert are instantiated
+// for every StatsPolicy in MonteCarloSimulator.cpp. A plain value updated by one
+// thread: each parallel worker builds its own inside the parallel region,
+// so it is first touched on that thread's NUMA node, and merges it into
+// the run total once. The alignment keeps neighbouring threads' blocks off
+// each other's cache lines. Score sums are not kept here: they are added
+// per chunk (ChunkMoments) or in round order (ACCURATE mode), so their
+// rounding does not depend on the schedule.
+struct alignas(Game::kCacheLineSize) RoundAccumulator {
+    ScoreHistogram histogram;           // Empty dividers: no histogram or top-k
+    std::vector<TopRound> top_values;   // Top 5, kept by updateTopValues
+    long long fg_triggered_count = 0, total_fg_runs = 0;
+    long long total_fg_picks = 0;       // FG picks played across all FG sessions
+    long long nonzero_bg = 0;           // Rounds with nonzero BG score
+    long long nonzero_fg_sessions = 0;  // FG sessions with nonzero total payout
+    long long nonzero_fg_picks = 0;     // FG picks with nonzero value
+    long long nonzero_total = 0;        // Rounds with nonzero total score
+    long long fg_capped_sessions = 0;   // FG sessions that hit the game's FG cap
+    long long fg_dropped_picks = 0;     // FG picks the cap dropped from them
+    long long max_fg_length = 0, max_bg_multiplier = 1, max_fg_multiplier = 1;
+    // Levels: BG items (per round), FG picks (per pick) and whole runs.
+    // The nonzero sums and counts skip level 1.
+    long long total_bg_levels = 0, bg_nonzero_levels_sum = 0, bg_nonzero_levels_count = 0;
+    long long total_fg_levels = 0, fg_nonzero_levels_sum = 0, fg_nonzero_levels_count = 0;
+    long long total_run_levels = 0, run_nonzero_levels_sum = 0, run_nonzero_levels_count = 0;
+    int max_bg_level = 0, max_fg_level = 0, max_run_level = 0;
+
+    RoundAccumulator() = default;
+    // Also bins every round's total score by dividers and keeps the top 5.
+    explicit RoundAccumulator(const std::vector<double>& dividers) {
+        histogram.dividers = dividers;
+        histogram.bins.assign(dividers.size() - 1, 0);
+    }
+
+    // Records every row of block. Row j is round first_round +
+    // block.roundOffset(j) of the run, for top-k.
+    template <Game::StatsPolicy Policy>
+    void addBlock(const Game::GameResultBlock& block, long long first_round);
+    // Records count inert BG rounds: zero score, BG level 1, no FG.
+    template <Game::StatsPolicy Policy>
+    void addInert(long long count);
+    void merge(const RoundAccumulator& other);
+};
+
+// Runs and analyzes simulations of one game. GameT is a game module policy
+// (e.g. Game::SS03Module) whose static members provide the kernels, and RngT
+// the generator every thread draws from (see Rng.h). Every registered module
+// and generator pair is explicitly instantiated in MonteCarloSimulator.cpp.
+template <typename GameT, typename RngT = Game::Xoshiro256pp>
 class MonteCarloSimulator {
 public:
     MonteCarloSimulator();
@@ -42,9 +111,88 @@ public:
     // The fallback run
     void run(long long numSimulations, Game::SimulationMode sim_mode, MemoryMode mem_mode, bool useParallel, double second_chance_prob = 0.0);
     void printResults(int base_bet = 20) const;
+    // Mean total score per round of the last run.
+    double mean() const { return m_stats.mean; }
+    // Top 5 rounds of the last run, best first, with the indices replayRound
+    // takes. Empty in EFFICIENT mode unless a histogram was configured.
+    const std::vector<TopRound>& topValues() const { return m_stats.top_values; }
+
+    // Two-phase FULL_GAME estimate: a BG_ONLY pass of k × m_bg rounds, then an
+    // FG_ONLY pass of k × m_fg sessions started as FULL_GAME rounds enter FG.
+    // The mean is E[BG] + P(enter FG) × E[FG | entered], which needs far fewer
+    // FG sessions than brute-force FULL_GAME rounds for the same precision.
+    // printResults reports the FG_ONLY pass followed by the combined estimate.
+    // Throws std::runtime_error if the game's FG_ONLY start is not "bg_entry".
+    void runTwoPhase(long long k, long long m_bg, long long m_fg, MemoryMode mem_mode, bool useParallel, double second_chance_prob = 0.0);
+
+    // Master seed of the following runs (default: taken from the clock). Each
+    // chunk of rounds (a batch of the batched run(), a fixed number of rounds
+    // in the fallback run()) draws from its own stream derived from the seed,
+    // the run's index since setSeed and the chunk index, and chunk results are
+    // merged in chunk order. Results for a seed are therefore bit-identical
+    // whatever the thread count, scheduling or machine.
+    void setSeed(uint64_t seed);
+    uint64_t seed() const { return m_seed; }
+
+    // Re-simulates round round_index of the last run and prints its trace: the
+    // BG outcome class, then every FG pick with its row, level, multiplier and
+    // retrigger grant. The index is the one shown next to the top values. The
+    // round's stream is re-seeded and fast-forwarded to it, so a replay costs
+    // at most one batch (or chunk) of rounds. Throws std::runtime_error for an
+    // index outside the run, or if the run used inert BG skip-ahead or the FG
+    // session cache, whose draws cannot be reproduced round by round.
+    Game::RoundTrace replayRound(long long round_index) const;
+    // The same for a batched run(k, m, sim_mode, mem_mode, ..., second_chance_prob)
+    // that need not have been simulated in this process, under the current
+    // seed, skip-ahead and cache settings. run is the run number printed with
+    // the seed (1 for the first run since setSeed).
+    Game::RoundTrace replayRound(long long k, long long m, Game::SimulationMode sim_mode, MemoryMode mem_mode,
+                                 double second_chance_prob, long long round_index, uint64_t run = 1) const;
+
+    // Selects which per-round statistics the next run collects (default FULL).
+    // Lighter policies skip the matching bookkeeping and report sections.
+    void setStatsPolicy(Game::StatsPolicy policy) { m_stats_policy = policy; }
+
+    // Enables geometric skip-ahead over inert BG rounds (FULL_GAME, EFFICIENT
+    // memory mode only). Skipped rounds are accounted in bulk; results are
+    // statistically identical to a plain run.
+    void setInertSkipAhead(bool enabled) { m_skip_inert_bg = enabled; }
+
+    // Enables the "fast BG sweep" engine: FULL_GAME runs draw each FG session
+    // from a cache of sessions_per_trigger pre-simulated sessions per initial
+    // trigger count (0 disables). The cache is kept across runs until the game
+    // data is reloaded, so sweeps over BG settings only pay for it once.
+    void setFGSessionCache(size_t sessions_per_trigger) { m_fg_cache_sessions = sessions_per_trigger; }
+
+    // Enables exact per-item counters: every BG outcome class and FG row gets a
+    // pick count and payout sum, kept per chunk and merged in chunk order, so
+    // the totals do not depend on the thread count. printResults then ranks
+    // the top report_rows entries of each table by RTP contribution. Every
+    // round is played in full while this is on, so inert BG skip-ahead and the
+    // FG session cache are not used.
+    void setItemContributions(bool enabled, size_t report_rows = 20) {
+        m_track_items = enabled;
+        m_item_report_rows = report_rows;
+    }
 
 private:
-    std::mt19937 m_rng; // Master RNG for seeding threads
+    uint64_t m_seed = 0;           // Master seed set by setSeed
+    uint64_t m_run_seed = 0;       // Seed of the current run, derived by beginRun
+    uint64_t m_runs_started = 0;   // Runs begun since setSeed
+
+    // How a run drew its rounds: everything replayRound needs to reproduce one.
+    struct RunLayout {
+        uint64_t seed = 0;                     // Master seed
+        uint64_t run = 0;                      // 1 for the first run since setSeed
+        uint64_t run_seed = 0;
+        Game::SimulationMode mode = Game::SimulationMode::FULL_GAME;
+        double second_chance_prob = 0.0;
+        long long rounds = 0;
+        long long rounds_per_stream = 0;       // m in the batched run, kRoundsPerChunk otherwise
+        const char* not_replayable = nullptr;  // Why its rounds cannot be replayed, if so
+
+        bool replayable() const { return rounds > 0 && not_replayable == nullptr; }
+    } m_layout;  // Of the last run
 
     // --- Data for ACCURATE mode ---
     std::vector<double> m_results;
@@ -53,56 +201,33 @@ private:
     OnlineStats m_final_online_stats;
     OnlineStats m_final_bg_online_stats;  // BG-only stats for stdDev calculation
 
+    // Floating-point sums of one chunk (or batch) of rounds. Merging them in
+    // chunk order keeps the totals independent of which thread ran which chunk.
+    // Aligned so threads filling neighbouring chunks never share a cache line.
+    struct alignas(Game::kCacheLineSize) ChunkMoments {
+        OnlineStats total;
+        OnlineStats bg;
+        double bg_score = 0.0;
+        double fg_score = 0.0;
+    };
+
     // --- Common Data --- 
-    struct Histogram {
-        std::vector<double> dividers; 
-        std::vector<long long> bins;
-        long long underflow = 0;
-        long long overflow = 0;
-    } m_histogram;
+    ScoreHistogram m_histogram;
     bool m_histogram_configured = false;
-    std::vector<double> m_top_values_tracker;
+    std::vector<TopRound> m_top_values_tracker;
     double m_avg_bg_value = 0.0;
 
+    using Accumulator = RoundAccumulator;
+
     // --- New members for CI calculations ---
     std::vector<double> m_batch_means;     // For Plan A (Efficient Mode)
     std::vector<double> m_bootstrap_means; // For Plan B (Accurate Mode)
 
-    // --- Thread-safe statistics for FG run length ---
-    std::atomic<long long> m_fg_triggered_count{0};
-    std::atomic<long long> m_total_fg_runs{0};
-    std::atomic<long long> m_total_fg_picks{0};      // Total FG items/picks processed across all FG sessions
-    std::atomic<long long> m_max_fg_length{0};
+    // Counters and maxima of the last run
+    Accumulator m_totals;
     // Trackers for score components
-    std::atomic<double> m_total_bg_score{0.0};
-    std::atomic<double> m_total_fg_score{0.0};
-    // Trackers for nonzero value frequencies
-    std::atomic<long long> m_nonzero_bg_count{0};         // Count of rounds with nonzero BG score
-    std::atomic<long long> m_nonzero_fg_sessions_count{0}; // Count of FG sessions with nonzero total payout
-    std::atomic<long long> m_nonzero_fg_picks_count{0};   // Count of individual FG picks with nonzero value
-    std::atomic<long long> m_nonzero_total_count{0};      // Count of rounds with nonzero total score
-    // Trackers for maximum multipliers
-    std::atomic<long long> m_max_bg_multiplier{1};        // Max BG multiplier observed (always 1 for this game)
-    std::atomic<long long> m_max_fg_multiplier{1};        // Max FG multiplier observed across all rounds
-
-    // --- Trackers for Levels Statistics ---
-    // Category 1: BG Items (denominator: m_stats.count)
-    std::atomic<long long> m_total_bg_levels{0};           // Sum of all BG levels
-    std::atomic<long long> m_bg_nonzero_levels_sum{0};     // Sum where level != 1
-    std::atomic<long long> m_bg_nonzero_levels_count{0};   // Count where level != 1
-    std::atomic<int> m_max_bg_level{0};                    // Max BG level
-
-    // Category 2: FG Picks (denominator: m_total_fg_picks - already exists!)
-    std::atomic<long long> m_total_fg_levels{0};           // Sum of all FG levels
-    std::atomic<long long> m_fg_nonzero_levels_sum{0};     // Sum where level != 1
-    std::atomic<long long> m_fg_nonzero_levels_count{0};   // Count where level != 1
-    std::atomic<int> m_max_fg_level{0};                    // Max FG level
-
-    // Category 3: Per Run (denominator: m_stats.count + m_total_fg_picks)
-    std::atomic<long long> m_total_run_levels{0};          // Sum of all levels (BG + FG)
-    std::atomic<long long> m_run_nonzero_levels_sum{0};    // Sum where level != 1
-    std::atomic<long long> m_run_nonzero_levels_count{0};  // Count where level != 1
-    std::atomic<int> m_max_run_level{0};                   // Max level in any run
+    double m_total_bg_score = 0.0;
+    double m_total_fg_score = 0.0;
 
     // --- Final Calculated Statistics ---
     struct Stats {
@@ -112,28 +237,66 @@ private:
         // Changed to 99th percentile
         double p95 = 0.0, p99 = 0.0; 
         // Added storage for top 5 values
-        std::vector<double> top_values; 
+        std::vector<TopRound> top_values;
         // --- Store multiple CIs in the final stats ---
         std::vector<ConfidenceInterval> confidence_intervals;
     } m_stats;
 
 
     MemoryMode m_mode;
+    Game::SimulationMode m_sim_mode = Game::SimulationMode::FULL_GAME;
+    double m_fg_entry_probability = 0.0;  // P(a FULL_GAME round enters FG) for the last run's settings
+
+    // Result of runTwoPhase; valid only after both passes completed.
+    struct TwoPhaseEstimate {
+        bool valid = false;
+        double bg_mean = 0.0, bg_std_error = 0.0;
+        long long bg_rounds = 0;
+        double fg_mean = 0.0, fg_std_error = 0.0;  // Per FG session
+        long long fg_sessions = 0;
+        double fg_entry_probability = 0.0;
+        double mean = 0.0, std_error = 0.0;
+    } m_two_phase;
+    Game::StatsPolicy m_stats_policy = Game::StatsPolicy::FULL;
+    bool m_skip_inert_bg = false;
+    size_t m_fg_cache_sessions = 0;
+    bool m_track_items = false;
+    size_t m_item_report_rows = 20;
+    Game::ItemContributions m_item_contributions;  // Merged per-item counters of the last run
 
     // --- Private Runner Methods ---
-    void runEfficientMode_Parallel(long long numSimulations, Game::SimulationMode sim_mode, double second_chance_prob);
-    void runAccurateMode_Parallel(long long numSimulations, Game::SimulationMode sim_mode, double second_chance_prob);
-    void runEfficientMode_SingleThread(long long numSimulations, Game::SimulationMode sim_mode, double second_chance_prob);
-    void runAccurateMode_SingleThread(long long numSimulations, Game::SimulationMode sim_mode, double second_chance_prob);
+    // Runners are templated on the simulation mode and stats policy so each
+    // combination gets its own kernel; run() picks one via dispatchKernel.
+    template <Game::SimulationMode Mode, Game::StatsPolicy Policy>
+    void runEfficientMode_Parallel(long long numSimulations, double second_chance_prob);
+    template <Game::SimulationMode Mode, Game::StatsPolicy Policy>
+    void runAccurateMode_Parallel(long long numSimulations, double second_chance_prob);
+    template <Game::SimulationMode Mode, Game::StatsPolicy Policy>
+    void runEfficientMode_SingleThread(long long numSimulations, double second_chance_prob);
+    template <Game::SimulationMode Mode, Game::StatsPolicy Policy>
+    void runAccurateMode_SingleThread(long long numSimulations, double second_chance_prob);
     
     // --- New Private Runner Methods for batched operations 
-    void runEfficientMode_Parallel(long long k, long long m, Game::SimulationMode sim_mode, double second_chance_prob);
-    void runAccurateMode_Parallel(long long k, long long m, Game::SimulationMode sim_mode, double second_chance_prob);
-    void runEfficientMode_SingleThread(long long k, long long m, Game::SimulationMode sim_mode, double second_chance_prob);
-    void runAccurateMode_SingleThread(long long k, long long m, Game::SimulationMode sim_mode, double second_chance_prob);
+    template <Game::SimulationMode Mode, Game::StatsPolicy Policy>
+    void runEfficientMode_Parallel(long long k, long long m, double second_chance_prob);
+    template <Game::SimulationMode Mode, Game::StatsPolicy Policy>
+    void runAccurateMode_Parallel(long long k, long long m, double second_chance_prob);
+    template <Game::SimulationMode Mode, Game::StatsPolicy Policy>
+    void runEfficientMode_SingleThread(long long k, long long m, double second_chance_prob);
+    template <Game::SimulationMode Mode, Game::StatsPolicy Policy>
+    void runAccurateMode_SingleThread(long long k, long long m, double second_chance_prob);
     
     // --- Private Helper Methods ---
     void resetState();
+    void beginRun(Game::SimulationMode sim_mode, double second_chance_prob);
+    uint64_t runSeed(uint64_t run) const;
+    RunLayout makeLayout(uint64_t run, Game::SimulationMode sim_mode, MemoryMode mem_mode, double second_chance_prob,
+                         long long rounds, long long rounds_per_stream) const;
+    Game::RoundTrace replayRound(const RunLayout& layout, long long round_index) const;
+    void prepareFGSessionCache(Game::SimulationMode sim_mode);
+    void mergeChunkMoments(const std::vector<ChunkMoments>& chunks);
+    void storeTotals(const Accumulator& totals);
+    void printItemContributions(int base_bet) const;
     void analyzeEfficientResults();
     void analyzeAccurateResults();
     double getPercentileFromHistogram(double percentile) const;
@@ -5,17 +5,15 @@
  *
  * HOW TO BUILD AND RUN:
  * ---------------------
- * This project uses CMake with automatic game module selection.
+ * This project uses CMake. One binary contains every game module; the game
+ * is chosen at runtime with --game (default SS03Game).
  *
  * METHOD 1: Quick Build Scripts (Recommended)
  * --------------------------------------------
- * For SS03Game:
- *   ./build_ss03.sh
- *   ./build/simulator
- *
- * For DeepDive:
- *   ./build_deepdive.sh
- *   ./build/simulator
+ *   ./build_ss03.sh        (or ./build_deepdive.sh; both build the same binary)
+ *   ./build/simulator --game SS03Game
+ *   ./build/simulator --game DeepDive
+ *   ./build/simulator --game DeepDive --config DeepDive_config.json
  *
  * METHOD 2: VS Code (Default: SS03Game)
  * --------------------------------------
@@ -26,29 +24,19 @@
  *
  * METHOD 3: Manual CMake
  * ----------------------
- * For SS03Game:
- *   cmake -B build -DGAME_MODULE=SS03Game -DCMAKE_CXX_COMPILER=/opt/homebrew/bin/g++-15
- *   cmake --build build
- *   ./build/simulator
- *
- * For DeepDive:
- *   cmake -B build -DGAME_MODULE=DeepDive -DCMAKE_CXX_COMPILER=/opt/homebrew/bin/g++-15
+ *   cmake -B build -DCMAKE_CXX_COMPILER=/opt/homebrew/bin/g++-15
  *   cmake --build build
- *   ./build/simulator
+ *   ./build/simulator --game <SS03Game|DeepDive> [--config <file>] [--rng <name>] [--seed <n>]
+ *   ./build/simulator --seed <n> --replay <round>   (trace one round of that run)
+ *   ./build/simulator --scaling <rounds>             (thread scaling benchmark)
  *
  * SWITCHING BETWEEN GAMES:
  * ------------------------
- * The game module is selected at COMPILE TIME, not in this file.
- *
- * 1. Choose which game you want to simulate
- * 2. Build with the appropriate method above
- * 3. Update the config file path below (line ~115)
- * 4. Run ./build/simulator
- *
- * You do NOT need to:
- * - Edit include statements (automatic via GameModule.h)
- * - Manually switch between DeepDive.h and SS03Game.h
- * - Clean build when switching (just rebuild)
+ * The game module is selected at RUNTIME with --game; no rebuild is needed.
+ * Each game gets its own statically compiled MonteCarloSimulator<GameT, RngT>
+ * (see GameModule.h), so there is no virtual dispatch in the hot loops.
+ * The generator is chosen the same way with --rng: xoshiro256pp (default,
+ * fastest) or philox4x32 (counter-based; see Rng.h).
  *
  * GAME-SPECIFIC CONFIGURATIONS:
  * ------------------------------
@@ -66,119 +54,273 @@
  * QUICK TROUBLESHOOTING:
  * ----------------------
  * Q: "array index 4 out of range" error?
- * A: You're running an old binary. Rebuild: ./build_ss03.sh
- *
- * Q: Namespace conflicts?
- * A: Clean rebuild: rm -rf build && ./build_ss03.sh
+ * A: The config file does not match the game. Check --game and --config.
  *
  * Q: Wrong game module loaded?
- * A: Make sure you built with the correct game module
+ * A: Pass --game explicitly; the [Init] line shows which game is running.
  *
  * For more details, see BUILD.md and SETUP_SUMMARY.md
  * ============================================================================
  */
 
 #include "MonteCarloSimulator.h"
+#include "GameModule.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
 #include <iostream>
+#include <omp.h>
+#include <optional>
+#include <sstream>
+#include <string>
 #include <vector>
 
 
-int main() {
-    try {
-        // --- Configuration ---
-        const int base_bet = 20;
-        const long long numSimulations = 1000000000;  // Total rounds (k × m)
-        const long long batches = 1000;               // Number of batches (k)
-        const long long batch_rounds = numSimulations/batches;  // Rounds per batch (m)
-
-        // ⚠️ MEMORY USAGE WARNING:
-        // ACCURATE Mode requires ~77 bytes per simulation (all stored in RAM)
-        //   - 1 billion simulations  ≈ 77 GB RAM
-        //   - 100 million simulations ≈ 7.7 GB RAM
-        //   - 10 million simulations  ≈ 770 MB RAM
-        //
-        // EFFICIENT Mode requires ~100 MB fixed (regardless of simulation count)
-        //
-        // Number of batches does NOT affect memory usage.
-        // Memory depends ONLY on total simulations (numSimulations = batches × batch_rounds)
-        //
-        // Recommendation:
-        //   - Use EFFICIENT mode for 100M+ simulations (production runs)
-        //   - Use ACCURATE mode only if you have sufficient RAM and need exact percentiles
-
-        // ========================================================================
-        // 🎮 GAME CONFIGURATION FILE
-        // ========================================================================
-        // IMPORTANT: The config file must match the game module you built with!
-        //
-    // For SS03Game (current default):
-    //      gameType => "SS03" uses SS03 flattened config
-    // For DeepDive:
-    //      gameType => "SS02" uses DeepDive configs
-#if defined(USE_SS03GAME)
-    static constexpr const char* kGameType = "SS03";
-    static constexpr const char* kConfigPath = "SS03_Config_Table01_v1.json"; // Default SS03 configuration
-#elif defined(USE_DEEPDIVE)
-    static constexpr const char* kGameType = "SS02";
-    static constexpr const char* kConfigPath = "SS02_Config_Table01_v1.json";       // Default DeepDive configuration
-#else
-#error "Unknown game module selected at build time"
-#endif
-    const std::string gameType{kGameType};
-    const std::string configFile{kConfigPath};
-        // ========================================================================
-        // --- Toggle for Parallel Processing ---
-        const bool useParallel = true;
-        // --- Optional factors to scale BG and FG item values during import ---
-        const double bg_value_factor = 1.0; // e.g., 0.9 to reduce all BG values by 10%
-        const double fg_value_factor = 1.0; // Keep FG values the same
-        // --- Simulation Mode and Second Chance Probability ---
-        const Game::SimulationMode sim_mode = Game::SimulationMode::FULL_GAME; // Options: FULL_GAME, FG_ONLY, BG_ONLY
-        const double second_chance_prob = 0.00;//47; //46;  e.g., 0.5% chance
-
-        // --- Initialization ---
-        std::cout << "[Init] Game Type: " << gameType
-                  << " | Config File: " << configFile << std::endl;
-        Game::initializeFromJSON(configFile,bg_value_factor,fg_value_factor);
-        //MonteCarloSimulator simulator1;
-        MonteCarloSimulator simulator2;
-
-        // --- CHOOSE YOUR HISTOGRAM STRATEGY (for EFFICIENT mode) ---
-        // Only one of these sections should be active.
-
-        // Option 1 (Recommended): Progressive Bins
-        //simulator.setProgressiveHistogramBins();
-
-        // Option 2: Custom Bins (Uncomment to use)
-        // Define bins as multiples of base_bet for easier configuration
-        std::vector<double> bin_multipliers = {1, 5, 10, 20, 35, 50, 100};
-        std::vector<double> my_bins;
-        for (double mult : bin_multipliers) {
-            my_bins.push_back(mult * base_bet);
+// Runs the configured simulation for one game module and generator.
+template <typename GameT, typename RngT>
+static void runSimulation(const std::string& configFile, std::optional<uint64_t> seed, std::optional<long long> replay) {
+    // --- Configuration ---
+    const int base_bet = 20;
+    const long long numSimulations = 1000000000;  // Total rounds (k × m)
+    const long long batches = 1000;               // Number of batches (k)
+    const long long batch_rounds = numSimulations/batches;  // Rounds per batch (m)
+
+    // ⚠️ MEMORY USAGE WARNING:
+    // ACCURATE Mode requires ~24 bytes per simulation (total, BG and FG score stored in RAM)
+    //   - 1 billion simulations  ≈ 24 GB RAM
+    //   - 100 million simulations ≈ 2.4 GB RAM
+    //   - 10 million simulations  ≈ 240 MB RAM
+    //
+    // EFFICIENT Mode requires ~100 MB fixed (regardless of simulation count)
+    //
+    // Number of batches does NOT affect memory usage.
+    // Memory depends ONLY on total simulations (numSimulations = batches × batch_rounds)
+    //
+    // Recommendation:
+    //   - Use EFFICIENT mode for 100M+ simulations (production runs)
+    //   - Use ACCURATE mode only if you have sufficient RAM and need exact percentiles
+
+    // ========================================================================
+    // 🎮 GAME AND CONFIGURATION FILE
+    // ========================================================================
+    // Both games are compiled in; pick one at runtime:
+    //      --game SS03Game  (default) uses GameT::default_config = "SS03_Config_Table01_v1.json"
+    //      --game DeepDive            uses GameT::default_config = "SS02_Config_Table01_v1.json"
+    // --config <file> overrides the default. The file must match the game's JSON format.
+    // ========================================================================
+    // --- Toggle for Parallel Processing ---
+    const bool useParallel = true;
+    // --- Optional factors to scale BG and FG item values during import ---
+    const double bg_value_factor = 1.0; // e.g., 0.9 to reduce all BG values by 10%
+    const double fg_value_factor = 1.0; // Keep FG values the same
+    // --- Simulation Mode and Second Chance Probability ---
+    const Game::SimulationMode sim_mode = Game::SimulationMode::FULL_GAME; // Options: FULL_GAME, FG_ONLY, BG_ONLY
+    const double second_chance_prob = 0.00;//47; //46;  e.g., 0.5% chance
+    // --- Statistics collected per round (MINIMAL is fastest, FULL reports everything) ---
+    const Game::StatsPolicy stats_policy = Game::StatsPolicy::FULL; // Options: MINIMAL, STANDARD, FULL
+    // --- Skip ahead over inert BG rounds (FULL_GAME + EFFICIENT only; same statistics, faster) ---
+    const bool skip_inert_bg = false;
+    // --- Fast BG sweep: FG sessions per trigger count to pre-simulate (0 = off, FULL_GAME only) ---
+    const size_t fg_cache_sessions = 0; // e.g., 1000000 for BG weight / value factor studies
+    // --- Per-item RTP contribution report (exact pick counts and payout per BG class / FG row) ---
+    const bool item_contributions = false;
+    // --- Two-phase FULL_GAME estimate: BG_ONLY pass + FG_ONLY pass (ignores sim_mode) ---
+    // The FG_ONLY pass plays only FG sessions, so it needs far fewer rounds per batch.
+    const bool two_phase = false;
+    const long long two_phase_fg_batch_rounds = batch_rounds / 100; // FG_ONLY sessions per batch
+
+    // --- Initialization ---
+    std::cout << "[Init] Game Type: " << GameT::name
+              << " | RNG: " << RngT::name
+              << " | Config File: " << configFile << std::endl;
+    GameT::initializeFromJSON(configFile,bg_value_factor,fg_value_factor);
+    //MonteCarloSimulator<GameT, RngT> simulator1;
+    MonteCarloSimulator<GameT, RngT> simulator2;
+
+    // --- CHOOSE YOUR HISTOGRAM STRATEGY (for EFFICIENT mode) ---
+    // Only one of these sections should be active.
+
+    // Option 1 (Recommended): Progressive Bins
+    //simulator.setProgressiveHistogramBins();
+
+    // Option 2: Custom Bins (Uncomment to use)
+    // Define bins as multiples of base_bet for easier configuration
+    std::vector<double> bin_multipliers = {1, 5, 10, 20, 35, 50, 100};
+    std::vector<double> my_bins;
+    for (double mult : bin_multipliers) {
+        my_bins.push_back(mult * base_bet);
+    }
+    //simulator1.setCustomHistogramBins(my_bins);
+    simulator2.setCustomHistogramBins(my_bins);
+    
+
+    // Option 3: Fixed-Width Bins (Uncomment to use)
+    /*
+    simulator.setFixedWidthHistogramBins(10000.0, 50); // Bins up to 10k
+    */
+    
+    // --- Execution ---
+    if (seed) simulator2.setSeed(*seed); // Otherwise seeded from the clock; the seed is printed either way
+    simulator2.setStatsPolicy(stats_policy);
+    simulator2.setInertSkipAhead(skip_inert_bg);
+    simulator2.setFGSessionCache(fg_cache_sessions);
+    simulator2.setItemContributions(item_contributions);
+    //simulator1.run(numSimulations, sim_mode, MemoryMode::ACCURATE, useParallel, second_chance_prob);
+    if (replay) {
+        // Re-simulate one round of the run these settings and seed produce; in
+        // two-phase mode that is the FG_ONLY pass, whose top values are reported.
+        if (two_phase) {
+            simulator2.replayRound(batches, two_phase_fg_batch_rounds, Game::SimulationMode::FG_ONLY, MemoryMode::EFFICIENT, second_chance_prob, *replay, 2);
+        } else {
+            simulator2.replayRound(batches, batch_rounds, sim_mode, MemoryMode::EFFICIENT, second_chance_prob, *replay);
         }
-        //simulator1.setCustomHistogramBins(my_bins);
-        simulator2.setCustomHistogramBins(my_bins);
-        
-
-        // Option 3: Fixed-Width Bins (Uncomment to use)
-        /*
-        simulator.setFixedWidthHistogramBins(10000.0, 50); // Bins up to 10k
-        */
-        
-        // --- Execution ---
-        //simulator1.run(numSimulations, sim_mode, MemoryMode::ACCURATE, useParallel, second_chance_prob);
+        return;
+    }
+    if (two_phase) {
+        simulator2.runTwoPhase(batches, batch_rounds, two_phase_fg_batch_rounds, MemoryMode::EFFICIENT, useParallel, second_chance_prob);
+    } else {
         simulator2.run(batches, batch_rounds, sim_mode, MemoryMode::EFFICIENT, useParallel, second_chance_prob);
+    }
+
+    //std::cout << "\n========================================" << std::endl;
+    //std::cout << "SIMULATOR 1: FALLBACK METHOD (No CI)" << std::endl;
+    //std::cout << "========================================" << std::endl;
+    //simulator1.printResults(base_bet);
 
-        //std::cout << "\n========================================" << std::endl;
-        //std::cout << "SIMULATOR 1: FALLBACK METHOD (No CI)" << std::endl;
-        //std::cout << "========================================" << std::endl;
-        //simulator1.printResults(base_bet);
+    std::cout << "\n\n========================================" << std::endl;
+    std::cout << "SIMULATOR 2: BATCH METHOD (With CI)" << std::endl;
+    std::cout << "========================================" << std::endl;
+    simulator2.printResults(base_bet);
+}
+
+// Times the same seeded FULL_GAME run on 1, 2, 4, ... threads up to every
+// available core and prints the speedup over one thread. The runs' own output
+// is suppressed; their means must agree, since results for a seed do not
+// depend on the thread count.
+template <typename GameT, typename RngT>
+static void runScalingBenchmark(const std::string& configFile, std::optional<uint64_t> seed, long long rounds) {
+    const long long batches = 100;
+    const long long batch_rounds = std::max(1LL, rounds / batches);
+    const uint64_t bench_seed = seed.value_or(1);
+
+    std::cout << "[Init] Game Type: " << GameT::name
+              << " | RNG: " << RngT::name
+              << " | Config File: " << configFile << std::endl;
+    GameT::initializeFromJSON(configFile, 1.0, 1.0);
+
+    const int max_threads = omp_get_max_threads();
+    std::vector<int> thread_counts;
+    for (int threads = 1; threads < max_threads; threads *= 2) thread_counts.push_back(threads);
+    thread_counts.push_back(max_threads);
+
+    std::cout << "[Scaling] " << batches << " batches x " << batch_rounds << " rounds, seed " << bench_seed << "\n"
+              << std::setw(8) << "Threads" << std::setw(12) << "Seconds" << std::setw(16) << "Rounds/s"
+              << std::setw(10) << "Speedup" << std::setw(12) << "Efficiency" << std::endl;
+    double base_seconds = 0.0, base_mean = 0.0;
+    bool same_mean = true;
+    for (int threads : thread_counts) {
+        omp_set_num_threads(threads);
+        std::ostringstream discarded;
+        std::streambuf* console = std::cout.rdbuf(discarded.rdbuf());
+        MonteCarloSimulator<GameT, RngT> simulator;
+        double seconds = 0.0;
+        try {
+            simulator.setProgressiveHistogramBins();
+            simulator.setSeed(bench_seed);
+            const auto start = std::chrono::steady_clock::now();
+            simulator.run(batches, batch_rounds, Game::SimulationMode::FULL_GAME, MemoryMode::EFFICIENT, true);
+            seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        } catch (...) {
+            std::cout.rdbuf(console);
+            throw;
+        }
+        std::cout.rdbuf(console);
+
+        if (threads == 1) {
+            base_seconds = seconds;
+            base_mean = simulator.mean();
+        } else if (simulator.mean() != base_mean) {
+            same_mean = false;
+        }
+        const double speedup = base_seconds / seconds;
+        std::cout << std::setw(8) << threads
+                  << std::setw(12) << std::fixed << std::setprecision(3) << seconds
+                  << std::setw(16) << std::setprecision(0) << (batches * batch_rounds / seconds)
+                  << std::setw(9) << std::setprecision(2) << speedup << "x"
+                  << std::setw(11) << std::setprecision(1) << (100.0 * speedup / threads) << "%" << std::endl;
+    }
+    omp_set_num_threads(max_threads);
+    std::cout << "[Scaling] Mean per round " << std::setprecision(6) << base_mean
+              << (same_mean ? " on every thread count." : " on 1 thread; OTHER THREAD COUNTS DIFFER.") << std::endl;
+}
+
+static void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " [--game <name>] [--config <file>] [--rng <name>] [--seed <n> [--replay <round>]]\n"
+              << "       " << program << " [--game <name>] [--config <file>] [--rng <name>] [--seed <n>] --scaling <rounds>\n"
+              << "  --game    Game module to simulate (default " << Game::SS03Module::name << ").\n"
+              << "            Registered games: " << Game::registeredGameNames() << "\n"
+              << "  --config  JSON configuration file (default depends on the game)\n"
+              << "  --rng     Random number generator (default " << Game::Xoshiro256pp::name << ").\n"
+              << "            Registered generators: " << Game::registeredRngNames() << "\n"
+              << "  --seed    Master seed (default: from the clock). A seed reproduces a run\n"
+              << "            exactly, whatever the thread count.\n"
+              << "  --replay  Instead of running, re-simulate one round of the run with this seed\n"
+              << "            and print its picks. Rounds are numbered as in the top values list.\n"
+              << "  --scaling Instead of the configured run, time a FULL_GAME run of this many rounds\n"
+              << "            on 1, 2, 4, ... threads up to every core and print the speedups." << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    try {
+        std::string gameName = Game::SS03Module::name;
+        std::string configFile;
+        std::string rngName = Game::Xoshiro256pp::name;
+        std::optional<uint64_t> seed;
+        std::optional<long long> replay;
+        std::optional<long long> scaling;
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            if ((arg == "--game" || arg == "--config" || arg == "--rng") && i + 1 < argc) {
+                (arg == "--game" ? gameName : arg == "--config" ? configFile : rngName) = argv[++i];
+            } else if (arg == "--seed" && i + 1 < argc) {
+                seed = std::stoull(argv[++i]);
+            } else if (arg == "--replay" && i + 1 < argc) {
+                replay = std::stoll(argv[++i]);
+            } else if (arg == "--scaling" && i + 1 < argc) {
+                scaling = std::stoll(argv[++i]);
+            } else if (arg == "--help" || arg == "-h") {
+                printUsage(argv[0]);
+                return 0;
+            } else {
+                std::cerr << "Unknown or incomplete argument: " << arg << std::endl;
+                printUsage(argv[0]);
+                return 1;
+            }
+        }
+
+        if (replay && !seed) {
+            std::cerr << "--replay needs the --seed of the run to replay." << std::endl;
+            printUsage(argv[0]);
+            return 1;
+        }
+        if (scaling && (replay || *scaling < 1)) {
+            std::cerr << "--scaling needs a positive round count and cannot be combined with --replay." << std::endl;
+            printUsage(argv[0]);
+            return 1;
+        }
 
-        std::cout << "\n\n========================================" << std::endl;
-        std::cout << "SIMULATOR 2: BATCH METHOD (With CI)" << std::endl;
-        std::cout << "========================================" << std::endl;
-        simulator2.printResults(base_bet);
-        
+        Game::dispatchGame(gameName, [&](auto module_tag) {
+            using GameT = typename decltype(module_tag)::type;
+            Game::dispatchRng(rngName, [&](auto rng_tag) {
+                using RngT = typename decltype(rng_tag)::type;
+                const std::string config = configFile.empty() ? std::string(GameT::default_config) : configFile;
+                if (scaling) {
+                    runScalingBenchmark<GameT, RngT>(config, seed, *scaling);
+                } else {
+                    runSimulation<GameT, RngT>(config, seed, replay);
+                }
+            });
+        });
 
     } catch (const std::exception& e) {
         std::cerr << "An error occurred: " << e.what() << std::endl;
@@ -0,0 +1,96 @@
+#ifndef PROGRESS_MONITOR_H
+#define PROGRESS_MONITOR_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include "AlignedColumn.h"
+
+namespace Game {
+
+    /**
+     * @brief Progress reporting for the parallel runners. Each worker counts
+     * its finished rounds in its own cache line, bumped once per chunk or
+     * batch with a plain store, so the hot loop shares nothing. A separate
+     * monitor thread wakes at a fixed wall-clock interval, sums the counters
+     * and prints the percentage done, the rounds per second and the time
+     * left. A run shorter than one interval prints nothing.
+     */
+    class ProgressMonitor {
+    public:
+        explicit ProgressMonitor(long long total_rounds, std::chrono::milliseconds interval = std::chrono::seconds(5))
+            : m_total_rounds(total_rounds), m_interval(interval) {}
+        ~ProgressMonitor() { stop(); }
+        ProgressMonitor(const ProgressMonitor&) = delete;
+        ProgressMonitor& operator=(const ProgressMonitor&) = delete;
+
+        // Allocates one counter per worker and starts the monitor thread.
+        // Must return before any worker calls add().
+        void start(int num_threads) {
+            m_counters.reset(new Counter[num_threads]);
+            m_num_threads = num_threads;
+            m_start = std::chrono::steady_clock::now();
+            m_thread = std::thread([this] { monitor(); });
+        }
+
+        // Records rounds finished by thread_id. Only that thread writes its
+        // counter, so a relaxed load and store replace an atomic add.
+        void add(int thread_id, long long rounds) {
+            std::atomic<long long>& done = m_counters[thread_id].rounds;
+            done.store(done.load(std::memory_order_relaxed) + rounds, std::memory_order_relaxed);
+        }
+
+        // Wakes and joins the monitor thread. Safe to call more than once.
+        void stop() {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stopping = true;
+            }
+            m_wake.notify_one();
+            if (m_thread.joinable()) m_thread.join();
+        }
+
+    private:
+        struct alignas(kCacheLineSize) Counter {
+            std::atomic<long long> rounds{0};
+        };
+
+        void monitor() {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            while (!m_wake.wait_for(lock, m_interval, [this] { return m_stopping; })) {
+                long long done = 0;
+                for (int t = 0; t < m_num_threads; ++t) done += m_counters[t].rounds.load(std::memory_order_relaxed);
+                const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start).count();
+                const double rate = seconds > 0.0 ? done / seconds : 0.0;
+
+                // Formatted apart so the stream flags of std::cout are left alone.
+                std::ostringstream line;
+                line << "          ... Progress: " << std::fixed << std::setprecision(1)
+                     << (m_total_rounds > 0 ? 100.0 * done / m_total_rounds : 100.0) << "% complete ("
+                     << done << "/" << m_total_rounds << " rounds, " << std::setprecision(0) << rate << " rounds/s";
+                if (rate > 0.0) line << ", ETA " << (m_total_rounds - done) / rate << " s";
+                line << ")\n";
+                std::cout << line.str() << std::flush;
+            }
+        }
+
+        const long long m_total_rounds;
+        const std::chrono::milliseconds m_interval;
+        std::unique_ptr<Counter[]> m_counters;
+        int m_num_threads = 0;
+        std::chrono::steady_clock::time_point m_start;
+        std::mutex m_mutex;
+        std::condition_variable m_wake;
+        bool m_stopping = false;
+        std::thread m_thread;
+    };
+
+} // namespace Game
+
+#endif // PROGRESS_MONITOR_H
@@ -0,0 +1,322 @@
+#ifndef RNG_H
+#define RNG_H
+
+// Random number generators for the simulation kernels. Every kernel and runner
+// is templated on the generator type, so a generator is any class with a
+// 64-bit operator() (a UniformRandomBitGenerator with result_type uint64_t)
+// and a constructor taking a 64-bit seed and a 64-bit stream id. Streams of
+// one seed are statistically independent; the simulator gives every chunk of
+// rounds its own stream so results do not depend on the thread count. Draws
+// are turned into doubles and bounded integers by the helpers below rather
+// than by std:: distribution objects, which keeps the per-draw cost to a few
+// instructions. A generator may also provide fillUniform(double*, size_t) to
+// produce a whole column of uniforms at once (see Philox4x32).
+//
+// To add a generator: define it here with a `name` and append it to
+// GAME_REGISTERED_RNGS; RegisteredRngs and the explicit instantiations in the
+// game .cpp files and MonteCarloSimulator.cpp follow from that list.
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "SimdBatch.h"
+
+namespace Game {
+
+    // One SplitMix64 step: advances state and returns a well-mixed 64-bit
+    // word. Used to expand a single seed into a generator's full state.
+    inline uint64_t splitMix64(uint64_t& state) {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    /**
+     * @brief xoshiro256++ (Blackman & Vigna): 32 bytes of state and a handful
+     * of adds, shifts and rotates per 64-bit draw. The default generator.
+     */
+    class Xoshiro256pp {
+    public:
+        using result_type = uint64_t;
+        static constexpr const char* name = "xoshiro256pp";
+
+        explicit Xoshiro256pp(uint64_t seed = 0, uint64_t stream = 0) { this->seed(seed, stream); }
+
+        // The stream id is hashed into the SplitMix64 start, so each stream
+        // begins at an unrelated point of the 2^256 - 1 period.
+        void seed(uint64_t seed, uint64_t stream = 0) {
+            uint64_t stream_state = stream;
+            uint64_t sm = seed ^ splitMix64(stream_state);
+            for (uint64_t& word : m_s) word = splitMix64(sm);
+        }
+
+        // Sets the four state words directly (not all zero), bypassing the
+        // seed expansion, e.g. to compare against the reference implementation.
+        void setState(uint64_t s0, uint64_t s1, uint64_t s2, uint64_t s3) {
+            m_s[0] = s0;
+            m_s[1] = s1;
+            m_s[2] = s2;
+            m_s[3] = s3;
+        }
+
+        static constexpr result_type min() { return 0; }
+        static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+        result_type operator()() {
+            const uint64_t result = rotl(m_s[0] + m_s[3], 23) + m_s[0];
+            const uint64_t t = m_s[1] << 17;
+            m_s[2] ^= m_s[0];
+            m_s[3] ^= m_s[1];
+            m_s[1] ^= m_s[2];
+            m_s[0] ^= m_s[3];
+            m_s[2] ^= t;
+            m_s[3] = rotl(m_s[3], 45);
+            return result;
+        }
+
+    private:
+        static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+        uint64_t m_s[4];
+    };
+
+    /**
+     * @brief Philox4x32-10 (Salmon et al., "Parallel random numbers: as easy
+     * as 1, 2, 3"): a counter-based generator. Output block i of stream s is
+     * a pure function of (seed, s, i), so any position can be reached without
+     * generating the draws before it. Each block yields two 64-bit draws.
+     */
+    class Philox4x32 {
+    public:
+        using result_type = uint64_t;
+        static constexpr const char* name = "philox4x32";
+
+        explicit Philox4x32(uint64_t seed = 0, uint64_t stream = 0) { this->seed(seed, stream); }
+
+        void seed(uint64_t seed, uint64_t stream = 0) {
+            m_key[0] = static_cast<uint32_t>(seed);
+            m_key[1] = static_cast<uint32_t>(seed >> 32);
+            m_stream = stream;
+            m_block = 0;
+            m_next = 2;
+        }
+
+        static constexpr result_type min() { return 0; }
+        static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+        result_type operator()() {
+            if (m_next == 2) {
+                uint32_t out[4];
+                block(m_block++, out);
+                m_out[0] = (static_cast<uint64_t>(out[1]) << 32) | out[0];
+                m_out[1] = (static_cast<uint64_t>(out[3]) << 32) | out[2];
+                m_next = 0;
+            }
+            return m_out[m_next++];
+        }
+
+        // Fills u[0, n) with what n calls of uniformUnit(*this) would return.
+        // Blocks are independent, so four of them are computed per AVX2 step.
+        void fillUniform(double* u, size_t n) {
+            size_t k = 0;
+            while (k < n && m_next < 2) u[k++] = toUnit(m_out[m_next++]);
+#if GAME_SIMD_X86
+            if (cpuHasAVX2()) {
+                const size_t blocks = (n - k) / 8 * 4;
+                fillBlocksAVX2(u + k, blocks);
+                k += 2 * blocks;
+            }
+#endif
+            for (; k < n; ++k) u[k] = toUnit((*this)());
+        }
+
+        // The raw 128-bit output for counter (index, stream) under this key.
+        void block(uint64_t index, uint32_t out[4]) const {
+            uint32_t c[4] = {static_cast<uint32_t>(index), static_cast<uint32_t>(index >> 32),
+                             static_cast<uint32_t>(m_stream), static_cast<uint32_t>(m_stream >> 32)};
+            uint32_t k0 = m_key[0], k1 = m_key[1];
+            for (int round = 0; round < 10; ++round) {
+                if (round > 0) {
+                    k0 += 0x9E3779B9u;
+                    k1 += 0xBB67AE85u;
+                }
+                const uint64_t p0 = static_cast<uint64_t>(0xD2511F53u) * c[0];
+                const uint64_t p1 = static_cast<uint64_t>(0xCD9E8D57u) * c[2];
+                const uint32_t next[4] = {static_cast<uint32_t>(p1 >> 32) ^ c[1] ^ k0, static_cast<uint32_t>(p1),
+                                          static_cast<uint32_t>(p0 >> 32) ^ c[3] ^ k1, static_cast<uint32_t>(p0)};
+                c[0] = next[0]; c[1] = next[1]; c[2] = next[2]; c[3] = next[3];
+            }
+            out[0] = c[0]; out[1] = c[1]; out[2] = c[2]; out[3] = c[3];
+        }
+
+    private:
+        // Same mapping as uniformUnit: the top 53 bits, scaled to [0, 1).
+        static double toUnit(uint64_t draw) { return static_cast<double>(draw >> 11) * 0x1.0p-53; }
+
+#if GAME_SIMD_X86
+        // toUnit on four lanes. AVX2 has no 64-bit integer to double conversion,
+        // so the 53-bit value is converted as two exact halves (27 and 26 bits)
+        // via the 2^52 exponent trick and recombined exactly.
+        __attribute__((target("avx2")))
+        static __m256d toUnitAVX2(__m256i draw) {
+            const __m256i exp52 = _mm256_castpd_si256(_mm256_set1_pd(0x1.0p52));
+            const __m256d two52 = _mm256_set1_pd(0x1.0p52);
+            const __m256i v = _mm256_srli_epi64(draw, 11);
+            const __m256d hi = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(_mm256_srli_epi64(v, 26), exp52)), two52);
+            const __m256d lo = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(_mm256_and_si256(v, _mm256_set1_epi64x((1LL << 26) - 1)), exp52)), two52);
+            return _mm256_mul_pd(_mm256_add_pd(_mm256_mul_pd(hi, _mm256_set1_pd(0x1.0p26)), lo), _mm256_set1_pd(0x1.0p-53));
+        }
+
+        // The next `blocks` blocks (a multiple of 4) as 2 * blocks uniforms.
+        // Lanes hold one block each, with every 32-bit word in the low half of
+        // a 64-bit lane so _mm256_mul_epu32 gives the full products.
+        __attribute__((target("avx2")))
+        void fillBlocksAVX2(double* u, size_t blocks) {
+            const __m256i low32 = _mm256_set1_epi64x(0xFFFFFFFFLL);
+            const __m256i m0 = _mm256_set1_epi64x(0xD2511F53LL);
+            const __m256i m1 = _mm256_set1_epi64x(0xCD9E8D57LL);
+            const __m256i s0 = _mm256_set1_epi64x(static_cast<uint32_t>(m_stream));
+            const __m256i s1 = _mm256_set1_epi64x(static_cast<uint32_t>(m_stream >> 32));
+            for (size_t b = 0; b < blocks; b += 4) {
+                const __m256i index = _mm256_add_epi64(_mm256_set1_epi64x(static_cast<long long>(m_block)), _mm256_set_epi64x(3, 2, 1, 0));
+                __m256i c0 = _mm256_and_si256(index, low32), c1 = _mm256_srli_epi64(index, 32), c2 = s0, c3 = s1;
+                uint32_t k0 = m_key[0], k1 = m_key[1];
+                for (int round = 0; round < 10; ++round) {
+                    if (round > 0) {
+                        k0 += 0x9E3779B9u;
+                        k1 += 0xBB67AE85u;
+                    }
+                    const __m256i p0 = _mm256_mul_epu32(m0, c0);
+                    const __m256i p1 = _mm256_mul_epu32(m1, c2);
+                    c0 = _mm256_xor_si256(_mm256_xor_si256(_mm256_srli_epi64(p1, 32), c1), _mm256_set1_epi64x(k0));
+                    c1 = _mm256_and_si256(p1, low32);
+                    c2 = _mm256_xor_si256(_mm256_xor_si256(_mm256_srli_epi64(p0, 32), c3), _mm256_set1_epi64x(k1));
+                    c3 = _mm256_and_si256(p0, low32);
+                }
+                m_block += 4;
+                // Block j yields draws (c1:c0) then (c3:c2); interleave them back into draw order.
+                const __m256d first = toUnitAVX2(_mm256_or_si256(_mm256_slli_epi64(c1, 32), c0));
+                const __m256d second = toUnitAVX2(_mm256_or_si256(_mm256_slli_epi64(c3, 32), c2));
+                const __m256d lo = _mm256_unpacklo_pd(first, second);
+                const __m256d hi = _mm256_unpackhi_pd(first, second);
+                _mm256_storeu_pd(u + 2 * b, _mm256_permute2f128_pd(lo, hi, 0x20));
+                _mm256_storeu_pd(u + 2 * b + 4, _mm256_permute2f128_pd(lo, hi, 0x31));
+            }
+        }
+#endif
+
+        uint32_t m_key[2];
+        uint64_t m_stream;
+        uint64_t m_block;
+        uint64_t m_out[2];
+        int m_next;
+    };
+
+    // Uniform double in [0, 1) from the top 53 bits of one draw.
+    template <typename Rng>
+    inline double uniformUnit(Rng& rng) {
+        static_assert(std::is_same_v<typename Rng::result_type, uint64_t>, "generators must produce 64-bit draws");
+        return static_cast<double>(rng() >> 11) * 0x1.0p-53;
+    }
+
+    namespace detail {
+        template <typename Rng, typename = void>
+        struct HasFillUniform : std::false_type {};
+        template <typename Rng>
+        struct HasFillUniform<Rng, std::void_t<decltype(std::declval<Rng&>().fillUniform(static_cast<double*>(nullptr), size_t{}))>>
+            : std::true_type {};
+    } // namespace detail
+
+    // Fills u[0, n) with what n calls of uniformUnit(rng) would return, through
+    // the generator's own batched fillUniform when it has one.
+    template <typename Rng>
+    inline void fillUniform(Rng& rng, double* u, size_t n) {
+        if constexpr (detail::HasFillUniform<Rng>::value) {
+            rng.fillUniform(u, n);
+        } else {
+            for (size_t i = 0; i < n; ++i) u[i] = uniformUnit(rng);
+        }
+    }
+
+    // Uniform integer in [0, n) for n >= 1, by Lemire's nearly divisionless
+    // method: the high word of draw × n, with a rejection (and the one
+    // division) only when the low word falls in the biased sliver below n.
+    template <typename Rng>
+    inline uint64_t uniformIndex(Rng& rng, uint64_t n) {
+        static_assert(std::is_same_v<typename Rng::result_type, uint64_t>, "generators must produce 64-bit draws");
+        auto multiply = [n](uint64_t x, uint64_t& lo) {
+#ifdef __SIZEOF_INT128__
+            const unsigned __int128 m = static_cast<unsigned __int128>(x) * n;
+            lo = static_cast<uint64_t>(m);
+            return static_cast<uint64_t>(m >> 64);
+#else
+            const uint64_t x_lo = x & 0xFFFFFFFFu, x_hi = x >> 32;
+            const uint64_t n_lo = n & 0xFFFFFFFFu, n_hi = n >> 32;
+            const uint64_t ll = x_lo * n_lo, lh = x_lo * n_hi, hl = x_hi * n_lo, hh = x_hi * n_hi;
+            const uint64_t mid = (ll >> 32) + (lh & 0xFFFFFFFFu) + (hl & 0xFFFFFFFFu);
+            lo = x * n;
+            return hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+#endif
+        };
+        uint64_t lo;
+        uint64_t hi = multiply(rng(), lo);
+        if (lo < n) {
+            const uint64_t threshold = (0 - n) % n;
+            while (lo < threshold) hi = multiply(rng(), lo);
+        }
+        return hi;
+    }
+
+    // Every generator the simulator is built with. GAME_REGISTERED_RNGS(X)
+    // expands X(Rng) once per generator, which is how the kernels and
+    // simulators are explicitly instantiated; RegisteredRngs is the same list
+    // as a type, for runtime selection.
+#define GAME_REGISTERED_RNGS(X) X(Xoshiro256pp) X(Philox4x32)
+#define GAME_RNG_TUPLE(Rng) std::declval<std::tuple<Rng>>(),
+    using RegisteredRngs = decltype(std::tuple_cat(GAME_REGISTERED_RNGS(GAME_RNG_TUPLE) std::tuple<>()));
+#undef GAME_RNG_TUPLE
+
+    // Tag carrying a generator type through a generic lambda.
+    template <typename Rng>
+    struct RngTag {
+        using type = Rng;
+    };
+
+    namespace detail {
+
+        template <typename Fn, typename... Rngs>
+        bool dispatchRngIn(const std::string& name, Fn& fn, std::tuple<Rngs...>*) {
+            return ((name == Rngs::name ? (fn(RngTag<Rngs>{}), true) : false) || ...);
+        }
+
+        template <typename... Rngs>
+        std::string rngNamesIn(std::tuple<Rngs...>*) {
+            std::string names;
+            ((names += (names.empty() ? "" : ", ") + std::string(Rngs::name)), ...);
+            return names;
+        }
+
+    } // namespace detail
+
+    // Comma-separated names of every registered generator, for usage messages.
+    inline std::string registeredRngNames() {
+        return detail::rngNamesIn(static_cast<RegisteredRngs*>(nullptr));
+    }
+
+    // Invokes fn(RngTag<R>{}) for the registered generator R called name.
+    // Throws std::runtime_error if no generator has that name.
+    template <typename Fn>
+    void dispatchRng(const std::string& name, Fn&& fn) {
+        if (!detail::dispatchRngIn(name, fn, static_cast<RegisteredRngs*>(nullptr))) {
+            throw std::runtime_error("Unknown RNG '" + name + "'. Registered generators: " + registeredRngNames());
+        }
+    }
+
+} // namespace Game
+
+#endif // RNG_H
@@ -0,0 +1,351 @@
+#ifndef ROUND_KERNELS_H
+#define ROUND_KERNELS_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "AlignedColumn.h"
+#include "FGRules.h"
+#include "GameTypes.h"
+#include "Rng.h"
+#include "SimdBatch.h"
+
+// Batched round kernels shared by every game module. Each game describes its
+// tables and FG session through a Kernel policy struct defined in its .cpp:
+//
+//   struct Kernel {
+//       using Result = GameResult;
+//       static const ItemColumns& columns();
+//       static int secondChancePicks();
+//       static Result emptyResult();
+//       template <SimulationMode Mode, StatsPolicy Policy, typename PickSink, typename Rng>
+//       static Result playRound(Rng&, double second_chance_prob, PickSink&);
+//       template <StatsPolicy Policy, typename PickSink, typename Rng>
+//       static void playFGSession(Rng&, int initial_picks, Result&, PickSink&);
+//   };
+//
+// ItemColumns must provide bg_classes (BGOutcomeClass records of four int32
+// fields: value, trigger_picks, levels, multiplier), bg_sampler, bg_row_class,
+// bg_inert_class, bg_inert_share and bg_eventful_sampler.
+namespace Game {
+
+    // Builds the BG half of a game's ItemColumns from its BG rows: collapses
+    // the rows into outcome classes in first-seen order, builds the class
+    // samplers, finds the inert class and resolves the FG_ONLY start table.
+    // triggerCount(item) is a row's trigger count under the game's table
+    // layout; rules turns it into picks and maps levels to multipliers.
+    template <typename ItemColumns, typename BGItem, typename TriggerCount>
+    void buildBGClasses(const std::vector<BGItem>& bg_items, const FGRules& rules, TriggerCount triggerCount,
+                        ItemColumns& cols, FGOnlyStartTable& fg_only_start) {
+        std::map<std::tuple<int, int, int>, int32_t> class_of;
+        std::vector<double> class_weight;
+        for (const BGItem& item : bg_items) {
+            const int trigger_picks = rules.triggerPicks(triggerCount(item));
+            const auto key = std::make_tuple(item.value, trigger_picks, item.levels);
+            auto it = class_of.find(key);
+            if (it == class_of.end()) {
+                it = class_of.emplace(key, static_cast<int32_t>(cols.bg_classes.size())).first;
+                cols.bg_classes.push_back({item.value, trigger_picks, item.levels,
+                                           rules.bg_level_multipliers.at(item.levels)});
+                class_weight.push_back(0.0);
+            }
+            class_weight[it->second] += 1.0;
+            cols.bg_row_class.push_back(it->second);
+        }
+        cols.bg_sampler.build(class_weight);
+
+        // BG_ENTRY FG_ONLY starts follow the BG trigger grants, weighted by row count.
+        std::map<int, double> trigger_weight;
+        for (size_t c = 0; c < cols.bg_classes.size(); ++c) {
+            const int32_t picks = cols.bg_classes[c].trigger_picks;
+            if (picks > 0) trigger_weight[picks] += class_weight[c];
+        }
+        fg_only_start.build(rules, trigger_weight, static_cast<double>(bg_items.size()));
+
+        std::vector<double> eventful_weight;
+        std::vector<int32_t> eventful_class;
+        for (size_t c = 0; c < cols.bg_classes.size(); ++c) {
+            const auto& bc = cols.bg_classes[c];
+            if (bc.value == 0 && bc.trigger_picks == 0 && bc.levels == 1) {
+                cols.bg_inert_class = static_cast<int32_t>(c);
+                cols.bg_inert_share = class_weight[c] / bg_items.size();
+            } else {
+                eventful_weight.push_back(class_weight[c]);
+                eventful_class.push_back(static_cast<int32_t>(c));
+            }
+        }
+        cols.bg_eventful_sampler.build(eventful_weight, eventful_class);
+    }
+
+    // One-line description of a BG outcome class and the BG rows in it, for
+    // reports.
+    template <typename ItemColumns, typename BGItem>
+    std::string describeBGClass(const ItemColumns& cols, const std::vector<BGItem>& bg_items, int32_t bg_class) {
+        const auto& bc = cols.bg_classes.at(bg_class);
+        std::ostringstream out;
+        out << "value " << bc.value << ", trigger picks " << bc.trigger_picks << ", levels " << bc.levels << ", rows";
+        // List the BG index of the first few rows in the class.
+        const size_t max_listed = 5;
+        size_t rows = 0;
+        for (size_t r = 0; r < cols.bg_row_class.size(); ++r) {
+            if (cols.bg_row_class[r] != bg_class) continue;
+            if (rows < max_listed) out << (rows > 0 ? ", " : " ") << bg_items[r].index;
+            rows++;
+        }
+        if (rows > max_listed) out << ", ... (" << rows << " rows)";
+        return out.str();
+    }
+
+    // Copies the BG fields of an outcome class into result, as far as Policy requires.
+    template <StatsPolicy Policy, typename BGClass, typename Result>
+    inline void applyBGClass(const BGClass& bg, Result& result) {
+        result.bg_score = bg.value;
+        if constexpr (tracksLevelStats<Policy>) {
+            result.bg_levels = bg.levels;
+        }
+        if constexpr (tracksRunStats<Policy>) {
+            result.max_bg_multiplier = bg.multiplier;
+        }
+    }
+
+    // Picks a round owes after its BG draw: the class's trigger picks, or the
+    // second chance picks when the class does not trigger and the second chance
+    // (probability second_chance_prob) succeeds.
+    template <typename Rng>
+    inline int applySecondChance(Rng& rng, int trigger_picks, double second_chance_prob, int second_chance_picks) {
+        if (trigger_picks == 0 && second_chance_prob > 0) {
+            if (uniformUnit(rng) < second_chance_prob) {
+                return second_chance_picks;
+            }
+        }
+        return trigger_picks;
+    }
+
+    // BG_ONLY batch: every round is one class draw, so the block is filled in
+    // column passes (uniforms, alias lookup, field gathers) that vectorize.
+    // Consumes the same uniforms in the same order as playRound, so the rows
+    // match the per-round kernel exactly.
+    template <typename Kernel, StatsPolicy Policy, typename Rng>
+    void fillBGOnlyRounds(Rng& rng, size_t n, GameResultBlock& out) {
+        const auto& cols = Kernel::columns();
+        const typename Kernel::Result defaults = Kernel::emptyResult();
+        if (cols.bg_classes.empty()) {
+            for (size_t i = 0; i < n; ++i) storeRow<Policy>(out, i, defaults);
+            return;
+        }
+
+        // Per-thread scratch for the class ids; grows once, then is reused.
+        thread_local AlignedColumn<int32_t> class_ids;
+        if (class_ids.size() < n) class_ids.resize(n);
+
+        double* u = out.bg_score.data();  // Uniforms are staged in bg_score, then overwritten
+        fillUniform(rng, u, n);
+        cols.bg_sampler.sampleBatch(u, n, class_ids.data());
+
+        // Class records are plain int32 fields, so each field is a strided int32 column.
+        using BGClass = typename std::decay_t<decltype(cols.bg_classes[0])>;
+        constexpr int32_t stride = sizeof(BGClass) / sizeof(int32_t);
+        const int32_t* fields = reinterpret_cast<const int32_t*>(cols.bg_classes.data());
+        gatherInt32(fields + offsetof(BGClass, value) / sizeof(int32_t), stride, class_ids.data(), n, out.bg_score.data());
+        std::fill_n(out.fg_score.begin(), n, 0.0);
+        if constexpr (tracksRunStats<Policy>) {
+            gatherInt32(fields + offsetof(BGClass, multiplier) / sizeof(int32_t), stride, class_ids.data(), n, out.max_bg_multiplier.data());
+            std::fill_n(out.fg_run_length.begin(), n, 0LL);
+            std::fill_n(out.flags.begin(), n, static_cast<unsigned char>(0));
+            std::fill_n(out.fg_nonzero_picks.begin(), n, 0LL);
+            std::fill_n(out.max_fg_multiplier.begin(), n, defaults.max_fg_multiplier);
+            std::fill_n(out.fg_dropped_picks.begin(), n, 0LL);
+        }
+        if constexpr (tracksLevelStats<Policy>) {
+            gatherInt32(fields + offsetof(BGClass, levels) / sizeof(int32_t), stride, class_ids.data(), n, out.bg_levels.data());
+            std::fill_n(out.fg_level_total.begin(), n, 0LL);
+            std::fill_n(out.fg_level_nonzero_sum.begin(), n, 0LL);
+            std::fill_n(out.fg_level_nonzero_count.begin(), n, 0LL);
+            std::fill_n(out.fg_level_max.begin(), n, 0);
+        }
+    }
+
+    // Fills a block with n rounds of the given mode; BG_ONLY goes through the
+    // column-pass kernel.
+    template <typename Kernel, SimulationMode Mode, StatsPolicy Policy, typename Rng>
+    void fillRounds(Rng& rng, double second_chance_prob, size_t n, GameResultBlock& out) {
+        if constexpr (Mode == SimulationMode::BG_ONLY) {
+            out.resize(n);
+            fillBGOnlyRounds<Kernel, Policy>(rng, n, out);
+        } else {
+            NullPickSink sink;
+            fillRounds<Kernel, Mode, Policy>(rng, second_chance_prob, n, out, sink);
+        }
+    }
+
+    // FULL_GAME batch that stores only eventful rounds. Inert rounds (inert
+    // class, second chance failed) are skipped in geometric gaps and counted in
+    // out.inert_rounds; the remaining rounds are drawn from their exact
+    // conditional distribution, so the block's totals match fillRounds.
+    template <typename Kernel, StatsPolicy Policy, typename Rng>
+    void fillRoundsSkippingInert(Rng& rng, double second_chance_prob, size_t n, GameResultBlock& out) {
+        const auto& cols = Kernel::columns();
+        // A round is inert when it lands on the inert class and its second chance fails.
+        const double inert_share = cols.bg_inert_class >= 0 ? cols.bg_inert_share : 0.0;
+        const double p_inert = inert_share * (1.0 - second_chance_prob);
+        if (p_inert <= 0.0) {
+            fillRounds<Kernel, SimulationMode::FULL_GAME, Policy>(rng, second_chance_prob, n, out);
+            return;
+        }
+        out.resize(n);
+        if (p_inert >= 1.0) {
+            out.size = 0;
+            out.inert_rounds = n;
+            return;
+        }
+
+        // Eventful rounds come either from an eventful class or from the inert
+        // class rescued by second chance (its share scaled by second_chance_prob).
+        const double p_from_eventful = (1.0 - inert_share) / ((1.0 - inert_share) + inert_share * second_chance_prob);
+        const int second_chance_picks = Kernel::secondChancePicks();
+        // Gaps are drawn by inverting the geometric CDF rather than through
+        // std::geometric_distribution, whose algorithm (and so the stream of
+        // gaps for a seed) is implementation-defined.
+        const double log_p_inert = std::log(p_inert);
+        NullPickSink sink;
+
+        size_t rows = 0;
+        size_t remaining = n;
+        while (remaining > 0) {
+            // Inert rounds before the next eventful one. The gap is memoryless, so
+            // one running past the end of the block is simply cut off there.
+            const double gap = std::floor(std::log1p(-uniformUnit(rng)) / log_p_inert);
+            if (gap >= static_cast<double>(remaining)) {
+                out.inert_rounds += remaining;
+                break;
+            }
+            out.inert_rounds += static_cast<size_t>(gap);
+            remaining -= static_cast<size_t>(gap);
+
+            typename Kernel::Result result = Kernel::emptyResult();
+            int initial_picks = second_chance_picks; // Inert class whose second chance already succeeded
+            if (!cols.bg_eventful_sampler.empty() && (p_from_eventful >= 1.0 || uniformUnit(rng) < p_from_eventful)) {
+                const auto& bg = cols.bg_classes[cols.bg_eventful_sampler.sample(rng)];
+                applyBGClass<Policy>(bg, result);
+                initial_picks = applySecondChance(rng, bg.trigger_picks, second_chance_prob, second_chance_picks);
+            } else {
+                applyBGClass<Policy>(cols.bg_classes[cols.bg_inert_class], result);
+            }
+
+            Kernel::template playFGSession<Policy>(rng, initial_picks, result, sink);
+            out.round_offset[rows] = n - remaining;
+            storeRow<Policy>(out, rows++, result);
+            remaining--;
+        }
+        out.size = rows;
+    }
+
+    // FG fields of one finished session, as stored by the session cache.
+    struct FGSessionOutcome {
+        double fg_score;
+        long long fg_run_length;
+        long long fg_nonzero_picks;
+        long long max_fg_multiplier;
+        FGLevelSummary fg_levels;
+        long long fg_dropped_picks;
+    };
+
+    // Pre-played FG sessions indexed by initial pick count; empty when
+    // disabled. Each game keeps one, built before a run and only read while
+    // rounds are simulated.
+    struct FGSessionCache {
+        std::vector<std::vector<FGSessionOutcome>> reservoirs;
+        size_t sessions = 0;  // Sessions per cached pick count; 0 when disabled
+
+        void clear() {
+            reservoirs.clear();
+            sessions = 0;
+        }
+
+        // Adds a random cached session of initial_picks picks to result, as far
+        // as Policy requires. Returns false, drawing nothing, when that pick
+        // count is not cached.
+        template <StatsPolicy Policy, typename Rng, typename Result>
+        bool draw(Rng& rng, int initial_picks, Result& result) const {
+            if (static_cast<size_t>(initial_picks) >= reservoirs.size() || reservoirs[initial_picks].empty()) return false;
+            const std::vector<FGSessionOutcome>& reservoir = reservoirs[initial_picks];
+            const FGSessionOutcome& session = reservoir[uniformIndex(rng, reservoir.size())];
+            result.fg_score += session.fg_score;
+            if constexpr (tracksRunStats<Policy>) {
+                result.fg_run_length += session.fg_run_length;
+                result.fg_nonzero_picks += session.fg_nonzero_picks;
+                if (session.max_fg_multiplier > result.max_fg_multiplier) {
+                    result.max_fg_multiplier = session.max_fg_multiplier;
+                }
+                result.fg_dropped_picks += session.fg_dropped_picks;
+            }
+            if constexpr (tracksLevelStats<Policy>) {
+                result.fg_levels = session.fg_levels;
+            }
+            return true;
+        }
+    };
+
+    // Rebuilds cache with sessions_per_trigger sessions, played live through
+    // Kernel::playFGSession, for every initial pick count a round can owe:
+    // the FG_ONLY starts in pick_counts, the second chance grant and each BG
+    // class's trigger grant.
+    template <typename Kernel, typename Rng>
+    void buildFGSessionCache(Rng& rng, std::vector<int> pick_counts, size_t sessions_per_trigger, FGSessionCache& cache) {
+        // The sessions must not come from the cache they fill, so drop it first.
+        cache.clear();
+        if (sessions_per_trigger == 0) return;
+
+        pick_counts.push_back(Kernel::secondChancePicks());
+        for (const auto& bg : Kernel::columns().bg_classes) {
+            if (bg.trigger_picks > 0) pick_counts.push_back(bg.trigger_picks);
+        }
+        const int max_picks = *std::max_element(pick_counts.begin(), pick_counts.end());
+
+        std::vector<std::vector<FGSessionOutcome>> reservoirs(static_cast<size_t>(max_picks) + 1);
+        NullPickSink sink;
+        for (int picks : pick_counts) {
+            std::vector<FGSessionOutcome>& reservoir = reservoirs[picks];
+            if (!reservoir.empty()) continue;
+            reservoir.reserve(sessions_per_trigger);
+            for (size_t i = 0; i < sessions_per_trigger; ++i) {
+                typename Kernel::Result r = Kernel::emptyResult();
+                Kernel::template playFGSession<StatsPolicy::FULL>(rng, picks, r, sink);
+                reservoir.push_back({r.fg_score, r.fg_run_length, r.fg_nonzero_picks, r.max_fg_multiplier, r.fg_levels, r.fg_dropped_picks});
+            }
+        }
+        cache.reservoirs = std::move(reservoirs);
+        cache.sessions = sessions_per_trigger;
+    }
+
+} // namespace Game
+
+// Explicit instantiations of a game's kernels for one generator. Every game
+// declares the same entry points in its own namespace, so each game .cpp
+// expands GAME_REGISTERED_RNGS(GAME_INSTANTIATE_KERNELS) inside it.
+#define GAME_INSTANTIATE_BATCH(Rng, Mode, Policy) \
+    template void simulateGameRounds<SimulationMode::Mode, StatsPolicy::Policy>(Rng&, double, size_t, GameResultBlock&); \
+    template void simulateGameRoundsTracked<SimulationMode::Mode, StatsPolicy::Policy>(Rng&, double, size_t, GameResultBlock&, ItemContributions&);
+#define GAME_INSTANTIATE_POLICY(Rng, Policy) \
+    GAME_INSTANTIATE_BATCH(Rng, FULL_GAME, Policy) \
+    GAME_INSTANTIATE_BATCH(Rng, FG_ONLY, Policy) \
+    GAME_INSTANTIATE_BATCH(Rng, BG_ONLY, Policy) \
+    template void simulateGameRoundsSkippingInert<StatsPolicy::Policy>(Rng&, double, size_t, GameResultBlock&);
+#define GAME_INSTANTIATE_KERNELS(Rng) \
+    template GameResult simulateGameRound(Rng&, SimulationMode, double); \
+    template GameResult simulateGameRound<NullPickSink>(Rng&, SimulationMode, double, NullPickSink&); \
+    template GameResult simulateGameRound<RoundTrace>(Rng&, SimulationMode, double, RoundTrace&); \
+    template void simulateGameRounds(Rng&, SimulationMode, double, size_t, GameResultBlock&); \
+    template void buildFGSessionCache(Rng&, size_t); \
+    GAME_INSTANTIATE_POLICY(Rng, MINIMAL) \
+    GAME_INSTANTIATE_POLICY(Rng, STANDARD) \
+    GAME_INSTANTIATE_POLICY(Rng, FULL)
+
+#endif // ROUND_KERNELS_H
@@ -2,6 +2,8 @@
 #include <fstream>
 #include <vector>
 #include <string>
+#include <map>
+#include <tuple>
 #include "json.hpp"
 
 using json = nlohmann::json;
@@ -19,8 +21,28 @@ struct FGItem {
     int flag;
     int count;
     int stop;
+    int pool_id = -1;  // Multiplier pool, or -1 when the item has no pool mapping
+    int weight = 1;    // Number of free game scripts merged into this item
 };
 
+// Merge FG items with identical (value, flag, count, stop, pool_id) into one
+// weighted item, keeping the first occurrence's index and the original order.
+std::vector<FGItem> collapseToWeighted(const std::vector<FGItem>& items) {
+    std::vector<FGItem> weighted;
+    std::map<std::tuple<int, int, int, int, int>, size_t> position;
+    for (const auto& item : items) {
+        auto key = std::make_tuple(item.value, item.flag, item.count, item.stop, item.pool_id);
+        auto it = position.find(key);
+        if (it == position.end()) {
+            position[key] = weighted.size();
+            weighted.push_back(item);
+        } else {
+            weighted[it->second].weight += item.weight;
+        }
+    }
+    return weighted;
+}
+
 // Count occurrences of a symbol in a board (6x5 grid)
 int countSymbolInBoard(const std::vector<std::vector<int>>& board, int symbol) {
     int count = 0;
@@ -82,7 +104,7 @@ int main() {
                         const auto& multipliers = pool["multiplier"];
                         const auto& weights = pool["weight"];
                         
-                        // Expand multipliers according to weights
+                        // Keep each multiplier once, as a [value, weight] pair
                         for (size_t i = 0; i < multipliers.size() && i < weights.size(); ++i) {
                             int mult = multipliers[i].get<int>();
                             int weight = weights[i].get<int>();
@@ -90,10 +112,7 @@ int main() {
                             // Convert from 1xx format to actual multiplier (102 -> 2, 103 -> 3, etc.)
                             int actualMult = mult - 100;
                             
-                            // Add multiplier 'weight' times
-                            for (int w = 0; w < weight; ++w) {
-                                poolArray.push_back(actualMult);
-                            }
+                            poolArray.push_back({actualMult, weight});
                         }
                         
                         multiplier_pools.push_back(poolArray);
@@ -225,8 +244,6 @@ int main() {
                     }
                 }
                 
-                fg_items.push_back({index, adjustedPayout, flag, multiplierCount, stop});
-                
                 // Map item to pool based on special_multipliers
                 int pool_id = 0;  // Default pool
                 if (scriptEntry.contains("special_multipliers")) {
@@ -235,7 +252,16 @@ int main() {
                         pool_id = 1;
                     }
                 }
-                item_to_pool_map[std::to_string(index)] = pool_id;
+                fg_items.push_back({index, adjustedPayout, flag, multiplierCount, stop, pool_id});
+            }
+        }
+
+        // Identical FG outcomes are written once with a weight; only the
+        // surviving indices need a pool mapping.
+        std::vector<FGItem> fg_weighted = collapseToWeighted(fg_items);
+        for (const auto& item : fg_weighted) {
+            if (item.pool_id >= 0) {
+                item_to_pool_map[std::to_string(item.index)] = item.pool_id;
             }
         }
 
@@ -249,10 +275,10 @@ int main() {
         }
         output["bg_items"] = bg_array;
 
-        // Convert fg_items to compact array format with stop field
+        // Convert weighted fg_items to compact array format with stop and weight fields
         json fg_array = json::array();
-        for (const auto& item : fg_items) {
-            fg_array.push_back({item.index, item.value, item.flag, item.count, item.stop});
+        for (const auto& item : fg_weighted) {
+            fg_array.push_back({item.index, item.value, item.flag, item.count, item.stop, item.weight});
         }
         output["fg_items"] = fg_array;
 
@@ -291,7 +317,7 @@ int main() {
                 outputFile << "    [";
                 const auto& pool = multiplier_pools[pool_idx];
                 for (size_t i = 0; i < pool.size(); ++i) {
-                    outputFile << pool[i].get<int>();
+                    outputFile << pool[i].dump();
                     if (i < pool.size() - 1) {
                         outputFile << ",";
                     }
@@ -336,7 +362,8 @@ int main() {
         }
         std::cout << "  - Trigger Items (flag=1): " << bg_triggers << std::endl;
 
-        std::cout << "FG Items (Free Game Scripts): " << fg_items.size() << std::endl;
+        std::cout << "FG Items (Free Game Scripts): " << fg_items.size()
+                  << " (" << fg_weighted.size() << " weighted rows written)" << std::endl;
         int fg_continues = 0;
         for (const auto& item : fg_items) {
             if (item.flag == 1) fg_continues++;
@@ -354,7 +381,8 @@ int main() {
 
         std::cout << "\n*** OUTPUT FORMAT ***" << std::endl;
         std::cout << "BG Items: [index, value, flag, stop]" << std::endl;
-        std::cout << "FG Items: [index, value, flag, count, stop]" << std::endl;
+        std::cout << "FG Items: [index, value, flag, count, stop, weight]" << std::endl;
+        std::cout << "Multiplier Pools: [[value, weight], ...] per pool" << std::endl;
 
         std::cout << "\nConversion complete!" << std::endl;
 
@@ -1,32 +1,97 @@
 #include "SS03Game.h"
+#include <atomic>
 #include <stdexcept>
 #include <iostream>
 #include <vector>
 #include <fstream>
 #include <numeric>
 #include <iomanip>
+#include <sstream>
 #include <map>
+#include <tuple>
+#include <algorithm>
+#include <type_traits>
+#include <cstddef>
+#include "RoundKernels.h"
+#include "FGRules.h"
 #include "json.hpp" // Assumes nlohmann/json library is available
 
 // Use the nlohmann namespace for convenience
 using json = nlohmann::json;
 
-namespace Game {
+namespace Game::SS03 {
 
     // --- Internal Game Data Storage (file-local) ---
     static GameData gameData;
     static std::atomic<bool> isInitialized = false;
 
-    // Safety limit to prevent a single game round from using too much memory.
-    const size_t MAX_QUEUE_SIZE = 2000;
+    // Safety limit on the number of FG picks still owed in a single game round.
+    // Pending picks are only counted, so this bounds session length, not memory.
+    // A session that owes more than this many picks ends there, and the picks
+    // still owed are dropped and counted in fg_dropped_picks.
+    const long long MAX_PENDING_PICKS = 2000;
+
+    // SS03's own FG rules: triggers and retriggers grant the item's count,
+    // the value already includes the multiplier, and levels map to
+    // multipliers {1→1, 2→2, 3→3, ≥4→5} in BG and {1→2, 2→4, 3→6, ≥4→10} in FG.
+    // FG_ONLY rounds start the way FULL_GAME rounds enter FG.
+    static FGRules defaultFGRules() {
+        FGRules rules;
+        rules.trigger = PickRule::ITEM_COUNT;
+        rules.retrigger = PickRule::ITEM_COUNT;
+        rules.second_chance_picks = 10;
+        rules.multiplier = MultiplierRule::IN_VALUE;
+        rules.bg_level_multipliers = {{1, 2, 3, 5}};
+        rules.fg_level_multipliers = {{2, 4, 6, 10}};
+        return rules;
+    }
+
+    // Rules of the loaded game; overridden by the config's "fg_rules" block.
+    static FGRules fgRules = defaultFGRules();
+
+    // FG_ONLY start distribution, resolved from fgRules and the BG table at load.
+    static FGOnlyStartTable fgOnlyStart;
+
+    // Session cache indexed by initial pick count; empty when disabled.
+    static FGSessionCache fgSessionCache;
 
     // Helper to clear data before loading
     static void clearGameData() {
         gameData.bg_items.clear();
         gameData.fg_items.clear();
+        gameData.columns = ItemColumns();
+        fgRules = defaultFGRules();
+        fgOnlyStart = FGOnlyStartTable();
+        fgSessionCache.clear();
         isInitialized = false;
     }
 
+    // Rebuilds the SoA item columns from bg_items/fg_items. Called once at the
+    // end of every initializer, before isInitialized is set. The FG rules are
+    // applied here: pick counts and level multipliers are resolved per row.
+    static void buildItemColumns() {
+        ItemColumns& cols = gameData.columns;
+        cols = ItemColumns();
+
+        buildBGClasses(gameData.bg_items, fgRules, [](const BG_Item& item) { return item.trigger_num; }, cols, fgOnlyStart);
+
+        const size_t num_fg = gameData.fg_items.size();
+        cols.fg_value.resize(num_fg);
+        cols.fg_retrigger_picks.resize(num_fg);
+        cols.fg_levels.resize(num_fg);
+        cols.fg_multiplier.resize(num_fg);
+        std::vector<double> fg_weight(num_fg);
+        for (size_t i = 0; i < num_fg; ++i) {
+            const FG_Item& item = gameData.fg_items[i];
+            cols.fg_value[i] = item.value;
+            cols.fg_retrigger_picks[i] = fgRules.retriggerPicks(item.retrigger_num);
+            cols.fg_levels[i] = item.levels;
+            cols.fg_multiplier[i] = fgRules.fg_level_multipliers.at(item.levels);
+            fg_weight[i] = item.weight;
+        }
+        cols.fg_sampler.build(fg_weight);
+    }
+
     /**
      * Initializes the game with hardcoded sample data for testing purposes.
      */
@@ -48,6 +113,7 @@ namespace Game {
             {103, 50, 0, 1}
         };
 
+        buildItemColumns();
         isInitialized = true;
         std::cout << "Sample data initialization complete." << std::endl;
     }
@@ -102,7 +168,8 @@ namespace Game {
                             item.at("index").get<int>(),
                             static_cast<int>(item.at("value").get<double>() * fg_value_factor),
                             item.at("retrigger_num").get<int>(),
-                            item.at("levels").get<int>()
+                            item.at("levels").get<int>(),
+                            item.value("weight", 1)
                         });
                     }
                 } else if (fg_items_json[0].is_array()) {
@@ -111,14 +178,20 @@ namespace Game {
                             item_arr.at(0).get<int>(),
                             static_cast<int>(item_arr.at(1).get<double>() * fg_value_factor),
                             item_arr.at(2).get<int>(),
-                            item_arr.at(3).get<int>()
+                            item_arr.at(3).get<int>(),
+                            item_arr.size() > 4 ? item_arr.at(4).get<int>() : 1
                         });
                     }
                 }
             }
+
+            readFGRules(data, fgRules);
         } catch (json::exception& e) {
             throw std::runtime_error("JSON parsing error: " + std::string(e.what()));
         }
+        if (fgRules.multiplier == MultiplierRule::POOL_SUM) {
+            throw std::runtime_error("fg_rules.multiplier \"pool_sum\" needs multiplier pools, which SS03Game configs do not have.");
+        }
 
         // --- Descriptive Statistics for Input Data ---
         std::cout << "\n------ Input Data Summary ------" << std::endl;
@@ -194,37 +267,44 @@ namespace Game {
                   << ", Avg (Total) = " << std::fixed << std::setprecision(4) << bg_avg_level_total
                   << ", Avg (Nonzero Value) = " << bg_avg_level_nonzero_value << std::endl;
 
-        // FG Items Stats
-        std::cout << "FG Items: " << gameData.fg_items.size() << " entries." << std::endl;
+        // FG Items Stats (weighted: an item of weight w counts as w raw rows)
+        long long fg_total_weight = 0;
+        for (const auto& item : gameData.fg_items) {
+            if (item.weight < 0) {
+                throw std::runtime_error("FG Item index " + std::to_string(item.index) + " has a negative weight.");
+            }
+            fg_total_weight += item.weight;
+        }
+        std::cout << "FG Items: " << gameData.fg_items.size() << " entries (total weight " << fg_total_weight << ")." << std::endl;
 
         // Calculate average retrigger_num and distribution
-        if (!gameData.fg_items.empty()) {
+        if (fg_total_weight > 0) {
             long long total_retrigger_num = 0;
             long long nonzero_retrigger_count = 0;
             long long nonzero_retrigger_sum = 0;
-            std::map<int, int> retrigger_distribution;
+            std::map<int, long long> retrigger_distribution;
 
             for (const auto& item : gameData.fg_items) {
-                total_retrigger_num += item.retrigger_num;
+                total_retrigger_num += static_cast<long long>(item.retrigger_num) * item.weight;
                 if (item.retrigger_num > 0) {
-                    nonzero_retrigger_count++;
-                    nonzero_retrigger_sum += item.retrigger_num;
+                    nonzero_retrigger_count += item.weight;
+                    nonzero_retrigger_sum += static_cast<long long>(item.retrigger_num) * item.weight;
                 }
-                retrigger_distribution[item.retrigger_num]++;
+                retrigger_distribution[item.retrigger_num] += item.weight;
             }
 
-            double avg_retrigger_num_total = static_cast<double>(total_retrigger_num) / gameData.fg_items.size();
+            double avg_retrigger_num_total = static_cast<double>(total_retrigger_num) / fg_total_weight;
             double avg_retrigger_num_nonzero = nonzero_retrigger_count == 0 ? 0.0 : static_cast<double>(nonzero_retrigger_sum) / nonzero_retrigger_count;
 
             std::cout << "  - Avg Retrigger Num: " << std::fixed << std::setprecision(4) << avg_retrigger_num_total
                       << " (Excl. 0's: " << avg_retrigger_num_nonzero << ")" << std::endl;
             std::cout << "  - Items with Retrigger > 0: " << nonzero_retrigger_count
                       << " (" << std::fixed << std::setprecision(2)
-                      << (100.0 * nonzero_retrigger_count / gameData.fg_items.size()) << "%)" << std::endl;
+                      << (100.0 * nonzero_retrigger_count / fg_total_weight) << "%)" << std::endl;
 
             std::cout << "  - Retrigger Distribution:" << std::endl;
             for (const auto& [retrigger_val, count] : retrigger_distribution) {
-                double percentage = 100.0 * count / gameData.fg_items.size();
+                double percentage = 100.0 * count / fg_total_weight;
                 std::cout << "      " << retrigger_val << ": " << count
                           << " (" << std::fixed << std::setprecision(2) << percentage << "%)" << std::endl;
             }
@@ -233,9 +313,9 @@ namespace Game {
         // FG Nonzero Values
         long long fg_nonzero_values = 0;
         for (const auto& item : gameData.fg_items) {
-            if (item.value != 0) fg_nonzero_values++;
+            if (item.value != 0) fg_nonzero_values += item.weight;
         }
-        double fg_nonzero_prob = gameData.fg_items.empty() ? 0.0 : 100.0 * static_cast<double>(fg_nonzero_values) / gameData.fg_items.size();
+        double fg_nonzero_prob = fg_total_weight == 0 ? 0.0 : 100.0 * static_cast<double>(fg_nonzero_values) / fg_total_weight;
         std::cout << "  - Nonzero Values: " << fg_nonzero_values
                   << " (" << std::fixed << std::setprecision(2) << fg_nonzero_prob << "%)" << std::endl;
 
@@ -252,169 +332,253 @@ namespace Game {
         long long fg_nonzero_value_levels_sum = 0;
         int fg_max_level = 0;
         for (const auto& item : gameData.fg_items) {
-            fg_total_levels += item.levels;
+            fg_total_levels += static_cast<long long>(item.levels) * item.weight;
             if (item.value != 0 && item.levels != 1) {
-                fg_nonzero_value_count++;
-                fg_nonzero_value_levels_sum += item.levels;
+                fg_nonzero_value_count += item.weight;
+                fg_nonzero_value_levels_sum += static_cast<long long>(item.levels) * item.weight;
             }
-            if (item.levels > fg_max_level) fg_max_level = item.levels;
+            if (item.weight > 0 && item.levels > fg_max_level) fg_max_level = item.levels;
         }
-        double fg_avg_level_total = gameData.fg_items.empty() ? 0.0 : static_cast<double>(fg_total_levels) / gameData.fg_items.size();
+        double fg_avg_level_total = fg_total_weight == 0 ? 0.0 : static_cast<double>(fg_total_levels) / fg_total_weight;
         double fg_avg_level_nonzero_value = fg_nonzero_value_count == 0 ? 0.0 : static_cast<double>(fg_nonzero_value_levels_sum) / fg_nonzero_value_count;
         std::cout << "  - Levels: Max = " << fg_max_level
                   << ", Avg (Total) = " << std::fixed << std::setprecision(4) << fg_avg_level_total
                   << ", Avg (Nonzero Value) = " << fg_avg_level_nonzero_value << std::endl;
 
+        buildItemColumns();
+        std::cout << "FG Rules: " << describeFGRules(fgRules) << std::endl;
+        std::cout << "BG Outcome Classes: " << gameData.columns.bg_classes.size()
+                  << " (from " << gameData.bg_items.size() << " items)" << std::endl;
         std::cout << "--------------------------------" << std::endl;
 
         isInitialized = true;
         std::cout << "JSON data initialization complete." << std::endl;
     }
 
+    // Plays the FG session of a round that owes initial_triggers picks,
+    // accumulating into result. Does nothing when initial_triggers is 0.
+    template <StatsPolicy Policy, typename PickSink, typename Rng>
+    static void playFGSession(Rng& rng, int initial_triggers, GameResult& result, PickSink& sink) {
+        if (initial_triggers <= 0) return;
+
+        const ItemColumns& cols = gameData.columns;
+        result.fg_was_triggered = true;
+        if (cols.fg_value.empty()) return; // No FG items to process
+
+        // Sessions nobody watches pick by pick can come from the cache.
+        if constexpr (std::is_same_v<PickSink, NullPickSink>) {
+            if (fgSessionCache.draw<Policy>(rng, initial_triggers, result)) return;
+        }
+
+        // FG picks are independent weighted draws, so the session only needs to
+        // know how many picks are still owed. Each item is drawn when processed.
+        long long pending_picks = initial_triggers;
+
+        while (pending_picks > 0) {
+            // Safety check to prevent runaway retrigger chains
+            if (pending_picks > MAX_PENDING_PICKS) {
+                if constexpr (tracksRunStats<Policy>) {
+                    result.fg_dropped_picks += pending_picks;
+                }
+                break;
+            }
+
+            result.fg_run_length++; // Count how many FG items are processed
+            pending_picks--;
+            const size_t fg = cols.fg_sampler.sample(rng);
+            const int32_t fg_value = cols.fg_value[fg];
+
+            // Track FG levels
+            if constexpr (tracksLevelStats<Policy>) {
+                result.fg_levels.add(cols.fg_levels[fg]);
+            }
+            sink.fgPick(static_cast<int32_t>(fg), cols.fg_levels[fg], cols.fg_multiplier[fg], cols.fg_retrigger_picks[fg], static_cast<double>(fg_value));
+
+            if constexpr (tracksRunStats<Policy>) {
+                // Track max FG multiplier (statistics only; the value already includes it)
+                long long fg_multiplier = cols.fg_multiplier[fg];
+                if (fg_multiplier > result.max_fg_multiplier) {
+                    result.max_fg_multiplier = fg_multiplier;
+                }
+
+                // Track nonzero picks
+                if (fg_value != 0) {
+                    result.fg_nonzero_picks++;
+                }
+            }
+
+            // Add the value directly (already includes multiplier)
+            result.fg_score += fg_value;
+
+            // If the item retriggers, owe the picks the retrigger rule grants
+            pending_picks += cols.fg_retrigger_picks[fg];
+        }
+    }
+
     /**
      * Simulates a single round of the new game, returning a detailed result.
-     * NOTE: The calling MonteCarloSimulator will need to be updated to handle
-     * the 'GameResult' struct instead of a simple 'double'. For now, it might
-     * just sum result.bg_score + result.fg_score.
+     * The mode and statistics policy are template parameters, so each combination
+     * compiles to its own loop with no per-round mode branches, and fields outside
+     * the policy are left at their defaults.
+     * Callers are responsible for the isInitialized check.
      */
-    GameResult simulateGameRound(std::mt19937& rng, SimulationMode mode, double second_chance_prob) {
-        if (!isInitialized) {
-            throw std::runtime_error("FATAL: Game logic called before data was initialized.");
-        }
+    template <SimulationMode Mode, StatsPolicy Policy, typename PickSink, typename Rng>
+    static GameResult playRound(Rng& rng, double second_chance_prob, PickSink& sink) {
 
+        const ItemColumns& cols = gameData.columns;
         GameResult result = {0.0, 0.0, 0, false, 0, 1, 1, 0, {}};
         int initial_triggers = 0;
 
         // --- Step 1: Handle the simulation mode ---
 
-        // BG_ONLY mode is simple: just pick a BG item and return its score.
-        if (mode == SimulationMode::BG_ONLY) {
-            if (gameData.bg_items.empty()) return result;
-            std::uniform_int_distribution<size_t> bg_dist(0, gameData.bg_items.size() - 1);
-            const BG_Item& chosen_bg = gameData.bg_items[bg_dist(rng)];
-            result.bg_score = chosen_bg.value;
-            result.bg_levels = chosen_bg.levels;
-            // Calculate max_bg_multiplier based on levels: {1→1, 2→2, 3→3, ≥4→5}
-            if (chosen_bg.levels <= 0) {
-                result.max_bg_multiplier = 1; // Safety: unexpected case, default to 1
-            } else if (chosen_bg.levels == 1) {
-                result.max_bg_multiplier = 1;
-            } else if (chosen_bg.levels == 2) {
-                result.max_bg_multiplier = 2;
-            } else if (chosen_bg.levels == 3) {
-                result.max_bg_multiplier = 3;
-            } else { // levels >= 4
-                result.max_bg_multiplier = 5;
+        if constexpr (Mode == SimulationMode::FG_ONLY) {
+            // FG_ONLY mode starts the FG sequence directly, with initial picks
+            // drawn per the FG_ONLY start rule (by default as FULL_GAME enters FG).
+            initial_triggers = fgOnlyStart.draw(rng, second_chance_prob);
+        } else {
+            // BG_ONLY and FULL_GAME modes both pick a BG item first.
+            if (cols.bg_classes.empty()) return result;
+            const int32_t bg_class = cols.bg_sampler.sample(rng);
+            const BGOutcomeClass& bg = cols.bg_classes[bg_class];
+            applyBGClass<Policy>(bg, result);
+            sink.bgPick(bg_class, result.bg_score);
+
+            // BG_ONLY mode is simple: just return the BG item's score.
+            if constexpr (Mode == SimulationMode::BG_ONLY) {
+                return result;
             }
-            return result;
+
+            initial_triggers = applySecondChance(rng, bg.trigger_picks, second_chance_prob, fgRules.second_chance_picks);
         }
 
-        // FG_ONLY mode starts the FG sequence directly with a fixed number of triggers.
-        if (mode == SimulationMode::FG_ONLY) {
-            initial_triggers = 10; // A reasonable default for starting the FG sequence.
-            result.fg_was_triggered = true;
+        // --- Step 2: Process the FG sequence if triggered ---
+
+        playFGSession<Policy>(rng, initial_triggers, result, sink);
+        return result;
+    }
+
+    // Runtime-mode entry to playRound, used by the single-round API.
+    template <StatsPolicy Policy, typename PickSink, typename Rng>
+    static GameResult playRound(Rng& rng, SimulationMode mode, double second_chance_prob, PickSink& sink) {
+        switch (mode) {
+            case SimulationMode::BG_ONLY: return playRound<SimulationMode::BG_ONLY, Policy>(rng, second_chance_prob, sink);
+            case SimulationMode::FG_ONLY: return playRound<SimulationMode::FG_ONLY, Policy>(rng, second_chance_prob, sink);
+            case SimulationMode::FULL_GAME: break;
         }
+        return playRound<SimulationMode::FULL_GAME, Policy>(rng, second_chance_prob, sink);
+    }
 
-        // FULL_GAME mode involves picking a BG item first.
-        if (mode == SimulationMode::FULL_GAME) {
-            if (gameData.bg_items.empty()) return result;
-            std::uniform_int_distribution<size_t> bg_dist(0, gameData.bg_items.size() - 1);
-            const BG_Item& chosen_bg = gameData.bg_items[bg_dist(rng)];
-            result.bg_score = chosen_bg.value;
-            result.bg_levels = chosen_bg.levels;
-            initial_triggers = chosen_bg.trigger_num;
-
-            // Calculate max_bg_multiplier based on levels: {1→1, 2→2, 3→3, ≥4→5}
-            if (chosen_bg.levels <= 0) {
-                result.max_bg_multiplier = 1; // Safety: unexpected case, default to 1
-            } else if (chosen_bg.levels == 1) {
-                result.max_bg_multiplier = 1;
-            } else if (chosen_bg.levels == 2) {
-                result.max_bg_multiplier = 2;
-            } else if (chosen_bg.levels == 3) {
-                result.max_bg_multiplier = 3;
-            } else { // levels >= 4
-                result.max_bg_multiplier = 5;
-            }
+    // The game's kernel policy for the shared block loops in RoundKernels.h.
+    struct Kernel {
+        using Result = GameResult;
+        static const ItemColumns& columns() { return gameData.columns; }
+        static int secondChancePicks() { return fgRules.second_chance_picks; }
+        static Result emptyResult() { return {0.0, 0.0, 0, false, 0, 1, 1, 0, {}}; }
 
-            // Apply the second chance probability if the initial trigger is zero.
-            if (initial_triggers == 0 && second_chance_prob > 0) {
-                std::uniform_real_distribution<double> chance_dist(0.0, 1.0);
-                if (chance_dist(rng) < second_chance_prob) {
-                    initial_triggers = 10; // Grant a single trigger on a successful second chance.
-                }
-            }
+        template <SimulationMode Mode, StatsPolicy Policy, typename PickSink, typename Rng>
+        static Result playRound(Rng& rng, double second_chance_prob, PickSink& sink) {
+            return SS03::playRound<Mode, Policy>(rng, second_chance_prob, sink);
         }
 
-        // --- Step 2: Process the FG sequence if triggered ---
+        template <StatsPolicy Policy, typename PickSink, typename Rng>
+        static void playFGSession(Rng& rng, int initial_picks, Result& result, PickSink& sink) {
+            SS03::playFGSession<Policy>(rng, initial_picks, result, sink);
+        }
+    };
 
-        if (initial_triggers > 0) {
-            result.fg_was_triggered = true;
-            if (gameData.fg_items.empty()) return result; // No FG items to process
+    template <typename PickSink, typename Rng>
+    GameResult simulateGameRound(Rng& rng, SimulationMode mode, double second_chance_prob, PickSink& sink) {
+        if (!isInitialized) {
+            throw std::runtime_error("FATAL: Game logic called before data was initialized.");
+        }
+        return playRound<StatsPolicy::FULL>(rng, mode, second_chance_prob, sink);
+    }
 
-            std::vector<FG_Item> fg_processing_queue;
-            fg_processing_queue.reserve(initial_triggers + 50); // Pre-allocate memory
-            std::uniform_int_distribution<size_t> fg_dist(0, gameData.fg_items.size() - 1);
+    template <typename Rng>
+    GameResult simulateGameRound(Rng& rng, SimulationMode mode, double second_chance_prob) {
+        NullPickSink sink;
+        return simulateGameRound(rng, mode, second_chance_prob, sink);
+    }
 
-            // Add the initial items to the queue
-            for (int i = 0; i < initial_triggers; ++i) {
-                fg_processing_queue.push_back(gameData.fg_items[fg_dist(rng)]);
-            }
+    template <SimulationMode Mode, StatsPolicy Policy, typename Rng>
+    void simulateGameRounds(Rng& rng, double second_chance_prob, size_t n, GameResultBlock& out) {
+        if (!isInitialized) {
+            throw std::runtime_error("FATAL: Game logic called before data was initialized.");
+        }
+        fillRounds<Kernel, Mode, Policy>(rng, second_chance_prob, n, out);
+    }
 
-            while (!fg_processing_queue.empty()) {
-                // Safety check to prevent infinite loops and excess memory use
-                if (fg_processing_queue.size() > MAX_QUEUE_SIZE) {
-                    break;
-                }
+    template <StatsPolicy Policy, typename Rng>
+    void simulateGameRoundsSkippingInert(Rng& rng, double second_chance_prob, size_t n, GameResultBlock& out) {
+        if (!isInitialized) {
+            throw std::runtime_error("FATAL: Game logic called before data was initialized.");
+        }
+        fillRoundsSkippingInert<Kernel, Policy>(rng, second_chance_prob, n, out);
+    }
 
-                result.fg_run_length++; // Count how many FG items are processed
-                FG_Item current_fg = fg_processing_queue.back();
-                fg_processing_queue.pop_back();
-
-                // Track FG levels
-                result.fg_levels.push_back(current_fg.levels);
-
-                // Calculate multiplier based on FG item levels (for statistics tracking only)
-                // The actual value already includes multiplier calculations
-                // Mapping: {1→2, 2→4, 3→6, ≥4→10}
-                long long fg_multiplier;
-                if (current_fg.levels <= 0) {
-                    fg_multiplier = 2; // Safety: unexpected case, default to 2
-                } else if (current_fg.levels == 1) {
-                    fg_multiplier = 2;
-                } else if (current_fg.levels == 2) {
-                    fg_multiplier = 4;
-                } else if (current_fg.levels == 3) {
-                    fg_multiplier = 6;
-                } else { // levels >= 4
-                    fg_multiplier = 10;
-                }
+    ItemContributions makeItemContributions() {
+        const ItemColumns& cols = gameData.columns;
+        ItemContributions counters;
+        counters.reset(cols.bg_classes.size(), cols.fg_value.size());
+        return counters;
+    }
 
-                // Track max FG multiplier (statistics only)
-                if (fg_multiplier > result.max_fg_multiplier) {
-                    result.max_fg_multiplier = fg_multiplier;
-                }
+    template <SimulationMode Mode, StatsPolicy Policy, typename Rng>
+    void simulateGameRoundsTracked(Rng& rng, double second_chance_prob, size_t n, GameResultBlock& out,
+                                   ItemContributions& counters) {
+        if (!isInitialized) {
+            throw std::runtime_error("FATAL: Game logic called before data was initialized.");
+        }
+        fillRoundsTracked<Kernel, Mode, Policy>(rng, second_chance_prob, n, out, counters);
+    }
 
-                // Add the value directly (already includes multiplier)
-                result.fg_score += current_fg.value;
+    double fgEntryProbability(double second_chance_prob) {
+        if (!isInitialized) {
+            throw std::runtime_error("FATAL: Game logic called before data was initialized.");
+        }
+        return fgOnlyStart.entryProbability(second_chance_prob);
+    }
 
-                // Track nonzero picks
-                if (current_fg.value != 0) {
-                    result.fg_nonzero_picks++;
-                }
+    bool fgOnlyStartsAtBGEntry() {
+        return fgOnlyStart.fromBG();
+    }
 
-                // If the item has retriggers, add more items to the queue
-                if (current_fg.retrigger_num > 0) {
-                    for (int i = 0; i < current_fg.retrigger_num; ++i) {
-                        fg_processing_queue.push_back(gameData.fg_items[fg_dist(rng)]);
-                    }
-                }
-            }
+    std::string describeBGClass(int32_t bg_class) {
+        return Game::describeBGClass(gameData.columns, gameData.bg_items, bg_class);
+    }
+
+    std::string describeFGRow(int32_t fg_row) {
+        const FG_Item& item = gameData.fg_items.at(fg_row);
+        std::ostringstream out;
+        out << "index " << item.index << ", value " << item.value << ", retriggers " << item.retrigger_num
+            << ", levels " << item.levels << ", weight " << item.weight;
+        return out.str();
+    }
+
+    template <typename Rng>
+    void buildFGSessionCache(Rng& rng, size_t sessions_per_trigger) {
+        if (!isInitialized) {
+            throw std::runtime_error("FATAL: Game logic called before data was initialized.");
         }
+        Game::buildFGSessionCache<Kernel>(rng, fgOnlyStart.pickCounts(), sessions_per_trigger, fgSessionCache);
+    }
 
-        return result;
+    size_t fgSessionCacheSize() {
+        return fgSessionCache.sessions;
+    }
+
+    template <typename Rng>
+    void simulateGameRounds(Rng& rng, SimulationMode mode, double second_chance_prob, size_t n, GameResultBlock& out) {
+        switch (mode) {
+            case SimulationMode::BG_ONLY: simulateGameRounds<SimulationMode::BG_ONLY, StatsPolicy::FULL>(rng, second_chance_prob, n, out); return;
+            case SimulationMode::FG_ONLY: simulateGameRounds<SimulationMode::FG_ONLY, StatsPolicy::FULL>(rng, second_chance_prob, n, out); return;
+            case SimulationMode::FULL_GAME: simulateGameRounds<SimulationMode::FULL_GAME, StatsPolicy::FULL>(rng, second_chance_prob, n, out); return;
+        }
     }
 
+    // Every kernel is instantiated once per generator registered in Rng.h.
+    GAME_REGISTERED_RNGS(GAME_INSTANTIATE_KERNELS)
+
     /**
      * Provides safe, read-only access to the loaded game data.
      */
@@ -422,4 +586,4 @@ namespace Game {
         return gameData;
     }
 
-} // namespace Game
+} // namespace Game::SS03
@@ -13,12 +13,15 @@
  *   - Free_Triggered: number of free games awarded (0, 10, 12, 14, etc.)
  *   - Steps: number of levels
  * 
- * Output format (both BG and FG use same structure):
- *   [index, value, trigger_num, levels]
+ * Output format:
+ *   BG: [index, value, trigger_num, levels]
+ *   FG: [index, value, trigger_num, levels, weight]
  *   - index: assigned by read order (1 to 10000)
  *   - value: Payout
  *   - trigger_num: Free_Triggered value (actual FG count: 0, 10, 12, 14, etc.)
  *   - levels: Steps + 1 from JSON
+ *   - weight: number of input files with this exact (value, trigger_num, levels);
+ *             identical FG outcomes are written once, under the first file's index
  */
 
 #include <iostream>
@@ -28,6 +31,7 @@
 #include <filesystem>
 #include <algorithm>
 #include <map>
+#include <tuple>
 #include "json.hpp"
 
 namespace fs = std::filesystem;
@@ -39,6 +43,7 @@ struct GameItem {
     int value;
     int trigger_num;  // Free_Triggered value (0, 10, 12, 14, etc.)
     int levels;       // Steps + 1
+    int weight = 1;   // Number of input files merged into this item
 };
 
 // Result structure to return items and scatter distribution
@@ -134,6 +139,24 @@ ProcessResult processDirectory(const std::string& basePath, const std::string& t
     return result;
 }
 
+// Merge items with identical (value, trigger_num, levels) into one weighted
+// item, keeping the first occurrence's index and the original order.
+std::vector<GameItem> collapseToWeighted(const std::vector<GameItem>& items) {
+    std::vector<GameItem> weighted;
+    std::map<std::tuple<int, int, int>, size_t> position;
+    for (const auto& item : items) {
+        auto key = std::make_tuple(item.value, item.trigger_num, item.levels);
+        auto it = position.find(key);
+        if (it == position.end()) {
+            position[key] = weighted.size();
+            weighted.push_back(item);
+        } else {
+            weighted[it->second].weight += item.weight;
+        }
+    }
+    return weighted;
+}
+
 int main() {
     try {
         const std::string bgPath = "SS03 Data/BG_ReelSets";
@@ -155,6 +178,8 @@ int main() {
         ProcessResult fg_result = processDirectory(fgPath, "FG");
         std::vector<GameItem>& fg_items = fg_result.items;
         std::cout << "  Found " << fg_items.size() << " unique FG items" << std::endl;
+        std::vector<GameItem> fg_weighted = collapseToWeighted(fg_items);
+        std::cout << "  Collapsed into " << fg_weighted.size() << " weighted FG items" << std::endl;
         
         // Create output JSON
         json output;
@@ -166,10 +191,10 @@ int main() {
         }
         output["bg_items"] = bg_array;
         
-        // Convert fg_items to compact array format [index, value, trigger_num, levels]
+        // Convert weighted fg_items to compact array format [index, value, trigger_num, levels, weight]
         json fg_array = json::array();
-        for (const auto& item : fg_items) {
-            fg_array.push_back({item.index, item.value, item.trigger_num, item.levels});
+        for (const auto& item : fg_weighted) {
+            fg_array.push_back({item.index, item.value, item.trigger_num, item.levels, item.weight});
         }
         output["fg_items"] = fg_array;
         
@@ -240,7 +265,7 @@ int main() {
         
         // FG Statistics
         std::cout << std::endl;
-        std::cout << "FG Items: " << fg_items.size() << " entries" << std::endl;
+        std::cout << "FG Items: " << fg_items.size() << " entries (" << fg_weighted.size() << " weighted rows written)" << std::endl;
         
         int fg_retriggers = 0;
         int fg_nonzero_values = 0;
@@ -274,7 +299,7 @@ int main() {
         std::cout << std::endl;
         std::cout << "*** OUTPUT FORMAT ***" << std::endl;
         std::cout << "BG Items: [index, value, trigger_num, levels]" << std::endl;
-        std::cout << "FG Items: [index, value, trigger_num, levels]" << std::endl;
+        std::cout << "FG Items: [index, value, trigger_num, levels, weight]" << std::endl;
         std::cout << std::endl;
         std::cout << "Conversion complete!" << std::endl;
         
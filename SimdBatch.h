@@ -0,0 +1,240 @@
+#ifndef SIMD_BATCH_H
+#define SIMD_BATCH_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// AVX2 and AVX-512 paths are compiled only for x86 with GCC/Clang, where they
+// can be enabled per function and selected at runtime. Everything else uses the
+// portable scalar loops, which produce bit-identical results.
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define GAME_SIMD_X86 1
+#include <immintrin.h>
+#else
+#define GAME_SIMD_X86 0
+#endif
+
+namespace Game {
+
+    // True when the running CPU supports SSE4.2 (and POPCNT). Checked once per process.
+    inline bool cpuHasSSE42() {
+#if GAME_SIMD_X86
+        static const bool has_sse42 = __builtin_cpu_supports("sse4.2") && __builtin_cpu_supports("popcnt");
+        return has_sse42;
+#else
+        return false;
+#endif
+    }
+
+    // True when the running CPU supports AVX2. Checked once per process.
+    inline bool cpuHasAVX2() {
+#if GAME_SIMD_X86
+        static const bool has_avx2 = __builtin_cpu_supports("avx2");
+        return has_avx2;
+#else
+        return false;
+#endif
+    }
+
+    // True when the running CPU supports AVX-512F. Checked once per process.
+    inline bool cpuHasAVX512() {
+#if GAME_SIMD_X86
+        static const bool has_avx512 = __builtin_cpu_supports("avx512f");
+        return has_avx512;
+#else
+        return false;
+#endif
+    }
+
+    namespace detail {
+
+        template <typename Out>
+        inline void gatherInt32Scalar(const int32_t* base, int32_t stride, const int32_t* ids, size_t n, Out* out) {
+            for (size_t i = 0; i < n; ++i) {
+                out[i] = static_cast<Out>(base[static_cast<size_t>(ids[i]) * stride]);
+            }
+        }
+
+#if GAME_SIMD_X86
+        template <typename Out>
+        __attribute__((target("avx2")))
+        inline void gatherInt32AVX2(const int32_t* base, int32_t stride, const int32_t* ids, size_t n, Out* out) {
+            const __m128i vstride = _mm_set1_epi32(stride);
+            size_t i = 0;
+            for (; i + 4 <= n; i += 4) {
+                const __m128i idx = _mm_mullo_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ids + i)), vstride);
+                const __m128i v = _mm_i32gather_epi32(base, idx, 4);
+                if constexpr (std::is_same_v<Out, double>) {
+                    _mm256_storeu_pd(out + i, _mm256_cvtepi32_pd(v));
+                } else if constexpr (sizeof(Out) == 8) {
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_cvtepi32_epi64(v));
+                } else {
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), v);
+                }
+            }
+            gatherInt32Scalar(base, stride, ids + i, n - i, out + i);
+        }
+#endif
+
+        inline size_t countNonzeroScalar(const double* x, size_t n) {
+            size_t count = 0;
+            for (size_t i = 0; i < n; ++i) count += x[i] != 0.0 ? 1 : 0;
+            return count;
+        }
+
+        // Lanes compare not-equal-unordered, so NaN counts as nonzero and -0.0
+        // as zero, exactly like x != 0.0.
+#if GAME_SIMD_X86
+        __attribute__((target("sse4.2,popcnt")))
+        inline size_t countNonzeroSSE42(const double* x, size_t n) {
+            const __m128d zero = _mm_setzero_pd();
+            size_t count = 0, i = 0;
+            for (; i + 2 <= n; i += 2) {
+                count += static_cast<size_t>(_mm_popcnt_u32(static_cast<unsigned>(_mm_movemask_pd(_mm_cmpneq_pd(_mm_loadu_pd(x + i), zero)))));
+            }
+            return count + countNonzeroScalar(x + i, n - i);
+        }
+
+        __attribute__((target("avx2,popcnt")))
+        inline size_t countNonzeroAVX2(const double* x, size_t n) {
+            const __m256d zero = _mm256_setzero_pd();
+            size_t count = 0, i = 0;
+            for (; i + 4 <= n; i += 4) {
+                const __m256d ne = _mm256_cmp_pd(_mm256_loadu_pd(x + i), zero, _CMP_NEQ_UQ);
+                count += static_cast<size_t>(_mm_popcnt_u32(static_cast<unsigned>(_mm256_movemask_pd(ne))));
+            }
+            return count + countNonzeroScalar(x + i, n - i);
+        }
+
+        __attribute__((target("avx512f,popcnt")))
+        inline size_t countNonzeroAVX512(const double* x, size_t n) {
+            const __m512d zero = _mm512_setzero_pd();
+            size_t count = 0, i = 0;
+            for (; i + 8 <= n; i += 8) {
+                count += static_cast<size_t>(_mm_popcnt_u32(_mm512_cmp_pd_mask(_mm512_loadu_pd(x + i), zero, _CMP_NEQ_UQ)));
+            }
+            return count + countNonzeroScalar(x + i, n - i);
+        }
+#endif
+
+        inline void upperBoundScalar(const double* sorted, size_t m, const double* x, size_t n, int32_t* out) {
+            for (size_t i = 0; i < n; ++i) {
+                out[i] = static_cast<int32_t>(std::upper_bound(sorted, sorted + m, x[i]) - sorted);
+            }
+        }
+
+#if GAME_SIMD_X86
+        // Narrows a 64-bit lane compare mask to 32-bit lanes.
+        __attribute__((target("avx2")))
+        inline __m128i narrowMaskAVX2(__m256d mask) {
+            const __m256 m32 = _mm256_castpd_ps(mask);
+            return _mm_castps_si128(_mm_shuffle_ps(_mm256_castps256_ps128(m32), _mm256_extractf128_ps(m32, 1), _MM_SHUFFLE(2, 0, 2, 0)));
+        }
+
+        // Branchless binary search: every lane takes the same log2(m) halving
+        // steps, gathering its probe and moving its base past it when the
+        // probe is <= x. The last probe settles the final position.
+        __attribute__((target("avx2")))
+        inline void upperBoundAVX2(const double* sorted, size_t m, const double* x, size_t n, int32_t* out) {
+            const __m256d all_lanes = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+            size_t i = 0;
+            for (; i + 4 <= n; i += 4) {
+                const __m256d v = _mm256_loadu_pd(x + i);
+                __m128i base = _mm_setzero_si128();
+                for (size_t len = m; len > 1;) {
+                    const size_t half = len / 2;
+                    const __m128i probe = _mm_add_epi32(base, _mm_set1_epi32(static_cast<int>(half)));
+                    const __m256d d = _mm256_mask_i32gather_pd(_mm256_setzero_pd(), sorted, probe, all_lanes, 8);
+                    base = _mm_blendv_epi8(base, probe, narrowMaskAVX2(_mm256_cmp_pd(d, v, _CMP_LE_OQ)));
+                    len -= half;
+                }
+                const __m256d d = _mm256_mask_i32gather_pd(_mm256_setzero_pd(), sorted, base, all_lanes, 8);
+                // A true compare lane is -1, so subtracting it adds one.
+                const __m128i pos = _mm_sub_epi32(base, narrowMaskAVX2(_mm256_cmp_pd(d, v, _CMP_LE_OQ)));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), pos);
+            }
+            upperBoundScalar(sorted, m, x + i, n - i, out + i);
+        }
+
+        // Eight lanes with 64-bit indices, so the gathers, blends and the
+        // final narrowing all stay within AVX-512F.
+        __attribute__((target("avx512f")))
+        inline void upperBoundAVX512(const double* sorted, size_t m, const double* x, size_t n, int32_t* out) {
+            const __m512i one = _mm512_set1_epi64(1);
+            size_t i = 0;
+            for (; i + 8 <= n; i += 8) {
+                const __m512d v = _mm512_loadu_pd(x + i);
+                __m512i base = _mm512_setzero_si512();
+                for (size_t len = m; len > 1;) {
+                    const size_t half = len / 2;
+                    const __m512i probe = _mm512_add_epi64(base, _mm512_set1_epi64(static_cast<long long>(half)));
+                    const __m512d d = _mm512_mask_i64gather_pd(_mm512_setzero_pd(), 0xFF, probe, sorted, 8);
+                    base = _mm512_mask_blend_epi64(_mm512_cmp_pd_mask(d, v, _CMP_LE_OQ), base, probe);
+                    len -= half;
+                }
+                const __m512d d = _mm512_mask_i64gather_pd(_mm512_setzero_pd(), 0xFF, base, sorted, 8);
+                const __m512i pos = _mm512_mask_add_epi64(base, _mm512_cmp_pd_mask(d, v, _CMP_LE_OQ), base, one);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm512_maskz_cvtepi64_epi32(0xFF, pos));
+            }
+            upperBoundScalar(sorted, m, x + i, n - i, out + i);
+        }
+#endif
+
+    } // namespace detail
+
+    /**
+     * @brief out[i] = base[ids[i] * stride] for i < n, converted to Out.
+     * Reads one int32 field out of an array of fixed-size records, e.g. one
+     * member of every sampled BG outcome class. out may alias ids when Out is
+     * a 32-bit integer.
+     */
+    template <typename Out>
+    inline void gatherInt32(const int32_t* base, int32_t stride, const int32_t* ids, size_t n, Out* out) {
+        static_assert(std::is_same_v<Out, double> || (std::is_integral_v<Out> && (sizeof(Out) == 4 || sizeof(Out) == 8)),
+                      "gatherInt32 writes double, 32-bit or 64-bit integers");
+#if GAME_SIMD_X86
+        if (cpuHasAVX2()) {
+            detail::gatherInt32AVX2(base, stride, ids, n, out);
+            return;
+        }
+#endif
+        detail::gatherInt32Scalar(base, stride, ids, n, out);
+    }
+
+    // Number of x[0, n) that compare != 0.0. Uses AVX-512, AVX2 or SSE4.2
+    // when the CPU supports them.
+    inline size_t countNonzero(const double* x, size_t n) {
+#if GAME_SIMD_X86
+        if (cpuHasAVX512()) return detail::countNonzeroAVX512(x, n);
+        if (cpuHasAVX2()) return detail::countNonzeroAVX2(x, n);
+        if (cpuHasSSE42()) return detail::countNonzeroSSE42(x, n);
+#endif
+        return detail::countNonzeroScalar(x, n);
+    }
+
+    /**
+     * @brief out[i] = std::upper_bound(sorted, sorted + m, x[i]) - sorted for
+     * i < n: the number of entries <= x[i], e.g. one past a value's histogram
+     * bin. sorted must be ascending with 1 <= m < 2^31. Uses AVX-512 or AVX2
+     * gathers when the CPU supports them; SSE4.2 has no gathers, so older CPUs
+     * take the scalar search.
+     */
+    inline void upperBoundBatch(const double* sorted, size_t m, const double* x, size_t n, int32_t* out) {
+#if GAME_SIMD_X86
+        if (cpuHasAVX512()) {
+            detail::upperBoundAVX512(sorted, m, x, n, out);
+            return;
+        }
+        if (cpuHasAVX2()) {
+            detail::upperBoundAVX2(sorted, m, x, n, out);
+            return;
+        }
+#endif
+        detail::upperBoundScalar(sorted, m, x, n, out);
+    }
+
+} // namespace Game
+
+#endif // SIMD_BATCH_H
@@ -108,9 +108,6 @@ namespace Statistics {
 
         // This function uses a combination of a lookup table for common, small df values
         // and approximation with Z-scores for larger df, which is a standard practice.
-        // The "alpha" is the area in the tails of the distribution.
-        double alpha = 1.0 - (confidence_level / 100.0);
-        double two_tailed_alpha = alpha / 2.0;
 
         // For larger degrees of freedom (df > 100 is a common rule of thumb),
         // the t-distribution is very close to the normal distribution (Z-distribution).
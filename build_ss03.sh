@@ -1,14 +1,13 @@
 #!/bin/bash
-# Build script for SS03Game module
+# Build script for the simulator (every game module is compiled in)
 
 echo "======================================"
 echo "Building Monte Carlo Simulator"
-echo "Game Module: SS03Game"
+echo "Game Modules: SS03Game, DeepDive"
 echo "======================================"
 
 # Configure with CMake
 cmake -B build \
-    -DGAME_MODULE=SS03Game \
     -DCMAKE_BUILD_TYPE=Release \
     -DCMAKE_CXX_COMPILER=/opt/homebrew/bin/g++-15
 
@@ -16,4 +15,4 @@ cmake -B build \
 cmake --build build -j 10
 
 echo ""
-echo "Build complete! Run with: ./build/simulator"
+echo "Build complete! Run with: ./build/simulator --game SS03Game"
@@ -0,0 +1,98 @@
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "GameModule.h"
+#include "MonteCarloSimulator.h"
+#include "TestHarness.h"
+
+using namespace Game;
+
+namespace {
+
+    void checkSameTotals(const RoundAccumulator& a, const RoundAccumulator& b) {
+        CHECK(a.histogram.bins == b.histogram.bins);
+        CHECK_EQ(a.histogram.underflow, b.histogram.underflow);
+        CHECK_EQ(a.histogram.overflow, b.histogram.overflow);
+        CHECK_EQ(a.top_values.size(), b.top_values.size());
+        for (size_t i = 0; i < a.top_values.size() && i < b.top_values.size(); ++i) {
+            CHECK_EQ(a.top_values[i].value, b.top_values[i].value);
+            CHECK_EQ(a.top_values[i].round, b.top_values[i].round);
+        }
+        CHECK_EQ(a.fg_triggered_count, b.fg_triggered_count);
+        CHECK_EQ(a.total_fg_runs, b.total_fg_runs);
+        CHECK_EQ(a.total_fg_picks, b.total_fg_picks);
+        CHECK_EQ(a.nonzero_bg, b.nonzero_bg);
+        CHECK_EQ(a.nonzero_fg_sessions, b.nonzero_fg_sessions);
+        CHECK_EQ(a.nonzero_fg_picks, b.nonzero_fg_picks);
+        CHECK_EQ(a.nonzero_total, b.nonzero_total);
+        CHECK_EQ(a.fg_capped_sessions, b.fg_capped_sessions);
+        CHECK_EQ(a.fg_dropped_picks, b.fg_dropped_picks);
+        CHECK_EQ(a.max_fg_length, b.max_fg_length);
+        CHECK_EQ(a.max_bg_multiplier, b.max_bg_multiplier);
+        CHECK_EQ(a.max_fg_multiplier, b.max_fg_multiplier);
+        CHECK_EQ(a.total_bg_levels, b.total_bg_levels);
+        CHECK_EQ(a.bg_nonzero_levels_sum, b.bg_nonzero_levels_sum);
+        CHECK_EQ(a.bg_nonzero_levels_count, b.bg_nonzero_levels_count);
+        CHECK_EQ(a.total_fg_levels, b.total_fg_levels);
+        CHECK_EQ(a.fg_nonzero_levels_sum, b.fg_nonzero_levels_sum);
+        CHECK_EQ(a.fg_nonzero_levels_count, b.fg_nonzero_levels_count);
+        CHECK_EQ(a.total_run_levels, b.total_run_levels);
+        CHECK_EQ(a.run_nonzero_levels_sum, b.run_nonzero_levels_sum);
+        CHECK_EQ(a.run_nonzero_levels_count, b.run_nonzero_levels_count);
+        CHECK_EQ(a.max_bg_level, b.max_bg_level);
+        CHECK_EQ(a.max_fg_level, b.max_fg_level);
+        CHECK_EQ(a.max_run_level, b.max_run_level);
+    }
+
+} // namespace
+
+// Blocks dealt round-robin to three accumulators and merged back, in an
+// order unrelated to the rounds, give exactly the single-pass totals,
+// skip-ahead blocks with inert rounds included. The single pass itself
+// matches a row-by-row recount of the histogram and nonzero totals.
+TEST_CASE(accumulator_merge_matches_single_pass) {
+    SS03Module::initializeFromJSON(std::string(TEST_DATA_DIR) + "/" + SS03Module::default_config, 1.0, 1.0);
+    const std::vector<double> dividers = {0.0, 1.0, 5.0, 20.0, 100.0, 400.0, 2000.0};
+    RoundAccumulator single(dividers);
+    std::vector<RoundAccumulator> parts(3, RoundAccumulator(dividers));
+
+    // Reference counts, kept row by row with std::upper_bound.
+    std::vector<long long> bins(dividers.size() - 1, 0);
+    long long nonzero_total = 0, overflow = 0;
+
+    Xoshiro256pp rng(2718, 0);
+    GameResultBlock block;
+    const size_t block_rounds = 1024;
+    for (int b = 0; b < 90; ++b) {
+        const long long first_round = static_cast<long long>(b) * block_rounds;
+        RoundAccumulator& part = parts[b % 3];
+        if (b % 2 == 0) {
+            SS03Module::simulateGameRounds<SimulationMode::FULL_GAME, StatsPolicy::FULL>(rng, 0.1, block_rounds, block);
+        } else {
+            SS03Module::simulateGameRoundsSkippingInert<StatsPolicy::FULL>(rng, 0.1, block_rounds, block);
+        }
+        single.addBlock<StatsPolicy::FULL>(block, first_round);
+        for (size_t j = 0; j < block.size; ++j) {
+            const double total = block.bg_score[j] + block.fg_score[j];
+            if (total != 0.0) nonzero_total++;
+            if (total >= dividers.back()) overflow++;
+            else bins[std::upper_bound(dividers.begin(), dividers.end(), total) - dividers.begin() - 1]++;
+        }
+        bins[0] += static_cast<long long>(block.inert_rounds);
+        part.addBlock<StatsPolicy::FULL>(block, first_round);
+        if (block.inert_rounds > 0) {
+            single.addInert<StatsPolicy::FULL>(static_cast<long long>(block.inert_rounds));
+            part.addInert<StatsPolicy::FULL>(static_cast<long long>(block.inert_rounds));
+        }
+    }
+
+    RoundAccumulator merged(dividers);
+    merged.merge(parts[2]);
+    merged.merge(parts[0]);
+    merged.merge(parts[1]);
+    checkSameTotals(merged, single);
+    CHECK(single.top_values.size() == 5);
+    CHECK(single.histogram.bins == bins);
+    CHECK_EQ(single.histogram.overflow, overflow);
+    CHECK_EQ(single.nonzero_total, nonzero_total);
+}
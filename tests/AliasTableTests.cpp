@@ -0,0 +1,64 @@
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+#include "AliasTable.h"
+#include "Rng.h"
+#include "TestHarness.h"
+
+using namespace Game;
+
+// Every outcome is drawn in proportion to its weight, within five standard
+// errors, and a zero weight is never drawn.
+TEST_CASE(alias_table_frequencies_match_weights) {
+    const std::vector<double> weights = {1.0, 0.0, 3.0, 6.0, 0.5, 2.5, 0.0, 7.0};
+    double total = 0.0;
+    for (double w : weights) total += w;
+
+    AliasTable table;
+    table.build(weights);
+    CHECK_EQ(table.size(), weights.size());
+
+    const long long draws = 2000000;
+    std::vector<long long> counts(weights.size(), 0);
+    Xoshiro256pp rng(20240611, 3);
+    for (long long d = 0; d < draws; ++d) counts[table.sample(rng)]++;
+
+    for (size_t i = 0; i < weights.size(); ++i) {
+        const double p = weights[i] / total;
+        if (p == 0.0) {
+            CHECK_EQ(counts[i], 0LL);
+            continue;
+        }
+        const double std_error = std::sqrt(p * (1.0 - p) / draws);
+        CHECK_NEAR(static_cast<double>(counts[i]) / draws, p, 5.0 * std_error);
+    }
+}
+
+// sample() returns the caller's ids, with the frequencies of their weights.
+TEST_CASE(alias_table_returns_ids) {
+    AliasTable table;
+    table.build({1.0, 3.0}, {40, 7});
+    const long long draws = 400000;
+    long long sevens = 0;
+    Philox4x32 rng(99, 1);
+    for (long long d = 0; d < draws; ++d) {
+        const int32_t id = table.sample(rng);
+        CHECK(id == 40 || id == 7);
+        if (id == 7) sevens++;
+    }
+    CHECK_NEAR(static_cast<double>(sevens) / draws, 0.75, 5.0 * std::sqrt(0.75 * 0.25 / draws));
+}
+
+TEST_CASE(alias_table_rejects_bad_weights) {
+    AliasTable table;
+    bool threw = false;
+    try { table.build({1.0, -1.0}); } catch (const std::runtime_error&) { threw = true; }
+    CHECK(threw);
+    threw = false;
+    try { table.build({0.0, 0.0}); } catch (const std::runtime_error&) { threw = true; }
+    CHECK(threw);
+    threw = false;
+    try { table.build({1.0, 2.0}, {5}); } catch (const std::runtime_error&) { threw = true; }
+    CHECK(threw);
+}
@@ -0,0 +1,82 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+#include <omp.h>
+#include "ChunkMerge.h"
+#include "GameTypes.h"
+#include "Rng.h"
+#include "TestHarness.h"
+
+using namespace Game;
+
+namespace {
+
+    // Counters of one chunk, with payouts spread over many magnitudes so that
+    // adding them up in a different order rounds differently.
+    ItemContributions chunkCounters(long long chunk) {
+        ItemContributions counters;
+        counters.reset(3, 2);
+        Xoshiro256pp rng(99, static_cast<uint64_t>(chunk));
+        for (size_t i = 0; i < 3; ++i) {
+            counters.bg_picks[i] = chunk + static_cast<long long>(i);
+            const double u = uniformUnit(rng) - 0.5;
+            counters.bg_payout[i] = std::ldexp(u, static_cast<int>(uniformIndex(rng, 60)));
+        }
+        for (size_t i = 0; i < 2; ++i) {
+            counters.fg_picks[i] = 1;
+            counters.fg_payout[i] = uniformUnit(rng) / 3.0;
+        }
+        return counters;
+    }
+
+    bool sameBits(const std::vector<double>& a, const std::vector<double>& b) {
+        return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(double)) == 0;
+    }
+
+    bool sameTotals(const ItemContributions& a, const ItemContributions& b) {
+        return a.bg_picks == b.bg_picks && a.fg_picks == b.fg_picks && sameBits(a.bg_payout, b.bg_payout) &&
+               sameBits(a.fg_payout, b.fg_payout);
+    }
+
+} // namespace
+
+// Chunks handed in any order, from any number of threads, merge to the same
+// bits as chunks handed in one by one in chunk order.
+TEST_CASE(chunk_merge_ignores_arrival_order) {
+    for (long long num_chunks : {1LL, 2LL, 5LL, 64LL, 1000LL}) {
+        ChunkOrderedMerge<ItemContributions> in_order(num_chunks);
+        for (long long c = 0; c < num_chunks; ++c) in_order.add(c, chunkCounters(c));
+
+        long long picks = 0;
+        for (long long c = 0; c < num_chunks; ++c) picks += c;
+        CHECK_EQ(in_order.total().bg_picks[0], picks);
+        CHECK_EQ(in_order.total().fg_picks[1], num_chunks);
+
+        std::vector<long long> order(static_cast<size_t>(num_chunks));
+        for (long long c = 0; c < num_chunks; ++c) order[c] = c;
+        Xoshiro256pp rng(5, static_cast<uint64_t>(num_chunks));
+        for (size_t i = order.size(); i > 1; --i) std::swap(order[i - 1], order[uniformIndex(rng, i)]);
+        ChunkOrderedMerge<ItemContributions> shuffled(num_chunks);
+        for (long long c : order) shuffled.add(c, chunkCounters(c));
+        CHECK(sameTotals(shuffled.total(), in_order.total()));
+
+        std::reverse(order.begin(), order.end());
+        ChunkOrderedMerge<ItemContributions> reversed(num_chunks);
+        for (long long c : order) reversed.add(c, chunkCounters(c));
+        CHECK(sameTotals(reversed.total(), in_order.total()));
+
+        for (int num_threads : {2, 3, 8}) {
+            ChunkOrderedMerge<ItemContributions> threaded(num_chunks);
+            #pragma omp parallel for num_threads(num_threads) schedule(dynamic, 3)
+            for (long long c = 0; c < num_chunks; ++c) threaded.add(c, chunkCounters(c));
+            CHECK(sameTotals(threaded.total(), in_order.total()));
+        }
+    }
+}
+
+TEST_CASE(chunk_merge_without_chunks_is_empty) {
+    ChunkOrderedMerge<ItemContributions> merge(0);
+    CHECK(merge.total().bg_picks.empty());
+    CHECK(merge.total().fg_payout.empty());
+}
@@ -0,0 +1,91 @@
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <omp.h>
+#include "ChunkScheduler.h"
+#include "TestHarness.h"
+
+using namespace Game;
+
+namespace {
+
+    // True when every chunk in [0, num_chunks) was claimed exactly once.
+    bool eachChunkOnce(const std::vector<std::vector<long long>>& claimed, long long num_chunks) {
+        std::vector<int> times(static_cast<size_t>(num_chunks), 0);
+        for (const std::vector<long long>& chunks : claimed) {
+            for (long long c : chunks) {
+                if (c < 0 || c >= num_chunks) return false;
+                times[static_cast<size_t>(c)]++;
+            }
+        }
+        for (int t : times) {
+            if (t != 1) return false;
+        }
+        return true;
+    }
+
+} // namespace
+
+// One thread plays both roles in turn: thread 1 drains its own share, then
+// keeps stealing the back half of what is left of thread 0's share until
+// nothing is, so thread 0 finds its share empty.
+TEST_CASE(chunk_scheduler_steals_back_half) {
+    ChunkScheduler scheduler;
+    scheduler.reset(10, 2);  // Shares [0, 5) and [5, 10)
+    std::vector<std::vector<long long>> claimed(2);
+    long long c;
+    while (scheduler.next(1, c)) claimed[1].push_back(c);
+    while (scheduler.next(0, c)) claimed[0].push_back(c);
+    CHECK(eachChunkOnce(claimed, 10));
+    const std::vector<long long> thief = {5, 6, 7, 8, 9, 2, 3, 4, 1, 0};
+    CHECK(claimed[1] == thief);
+    CHECK(claimed[0].empty());
+}
+
+// Real threads, one of them slowed down so the others run dry and steal
+// from it: every chunk is still handed out exactly once.
+TEST_CASE(chunk_scheduler_covers_every_chunk_once) {
+    for (int num_threads : {1, 2, 3, 4, 8}) {
+        for (long long num_chunks : {0LL, 1LL, 7LL, 64LL, 1000LL}) {
+            ChunkScheduler scheduler;
+            scheduler.reset(num_chunks, num_threads);
+            std::vector<std::vector<long long>> claimed(static_cast<size_t>(num_threads));
+            int team_size = 0;
+            #pragma omp parallel num_threads(num_threads)
+            {
+                #pragma omp master
+                team_size = omp_get_num_threads();
+                const int thread_id = omp_get_thread_num();
+                long long c;
+                while (scheduler.next(thread_id, c)) {
+                    claimed[thread_id].push_back(c);
+                    if (thread_id == 0) std::this_thread::sleep_for(std::chrono::microseconds(200));
+                }
+            }
+            if (team_size != num_threads) continue;  // Shares of threads OpenMP did not start were never claimed
+            CHECK(eachChunkOnce(claimed, num_chunks));
+
+            // Thread 0's own share is [0, num_chunks / num_threads); with the
+            // others idle while it sleeps, some of it must have been stolen.
+            if (num_threads > 1 && num_chunks >= 64) {
+                long long stolen = 0;
+                for (int t = 1; t < num_threads; ++t) {
+                    for (long long chunk : claimed[t]) stolen += chunk < num_chunks / num_threads ? 1 : 0;
+                }
+                CHECK(stolen > 0);
+            }
+        }
+    }
+}
+
+TEST_CASE(chunk_scheduler_rejects_bad_chunk_counts) {
+    bool threw = false;
+    try { ChunkScheduler::checkChunkCount(-1); } catch (const std::runtime_error&) { threw = true; }
+    CHECK(threw);
+    threw = false;
+    try { ChunkScheduler::checkChunkCount(1LL << 32); } catch (const std::runtime_error&) { threw = true; }
+    CHECK(threw);
+    ChunkScheduler::checkChunkCount(0);
+    ChunkScheduler::checkChunkCount((1LL << 32) - 1);
+}
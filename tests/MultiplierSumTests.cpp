@@ -0,0 +1,88 @@
+#include <cmath>
+#include <map>
+#include <string>
+#include <vector>
+#include "DeepDive.h"
+#include "Rng.h"
+#include "TestHarness.h"
+
+using namespace Game;
+using namespace Game::DeepDive;
+
+namespace {
+
+    // Brute force: enumerates every sequence of count pool entries and adds
+    // up the product of their probabilities under its total.
+    std::map<long long, double> enumerateSums(const MultiplierPool& pool, int count) {
+        double total_weight = 0.0;
+        for (const PoolEntry& entry : pool) total_weight += static_cast<double>(entry.weight);
+        std::map<long long, double> sums;
+        std::vector<size_t> pick(count, 0);
+        for (;;) {
+            long long sum = 0;
+            double p = 1.0;
+            for (size_t e : pick) {
+                sum += pool[e].value;
+                p *= pool[e].weight / total_weight;
+            }
+            if (p > 0.0) sums[sum] += p;
+
+            int c = 0;
+            while (c < count && ++pick[c] == pool.size()) pick[c++] = 0;
+            if (c == count) return sums;
+        }
+    }
+
+    void checkSameDistribution(const std::map<long long, double>& got, const std::map<long long, double>& expected) {
+        CHECK_EQ(got.size(), expected.size());
+        auto it = expected.begin();
+        for (const auto& [sum, p] : got) {
+            if (it == expected.end()) break;
+            CHECK_EQ(sum, it->first);
+            CHECK_NEAR(p, it->second, 1e-12);
+            ++it;
+        }
+    }
+
+} // namespace
+
+// The convolution matches brute-force enumeration, with repeated values,
+// zero weights and negative multipliers.
+TEST_CASE(multiplier_sum_matches_enumeration) {
+    const std::vector<MultiplierPool> pools = {
+        {{2, 5}, {3, 3}, {5, 1}, {10, 1}},
+        {{1, 1}, {1, 2}, {4, 0}, {7, 3}},
+        {{-2, 1}, {0, 4}, {6, 2}},
+        {{100, 7}},
+    };
+    for (const MultiplierPool& pool : pools) {
+        for (int count = 0; count <= 4; ++count) {
+            checkSameDistribution(multiplierSumDistribution(pool, count), enumerateSums(pool, count));
+        }
+    }
+}
+
+// The tables built at load time hold the convolved totals and draw each one
+// with its probability, within five standard errors.
+TEST_CASE(multiplier_sum_tables_sample_the_distribution) {
+    initializeFromJSON(std::string(TEST_DATA_DIR) + "/" + DeepDiveModule::default_config, 1.0, 1.0);
+    const DeepDiveData& data = getGameData();
+    CHECK(!data.columns.multiplier_sums.empty());
+
+    Xoshiro256pp rng(123, 0);
+    const long long draws = 400000;
+    for (const MultiplierSumTable& table : data.columns.multiplier_sums) {
+        const std::map<long long, double> expected = multiplierSumDistribution(data.multiplier_pools[table.pool_id], table.count);
+        CHECK_EQ(table.sums.size(), expected.size());
+        if (table.sums.size() != expected.size()) continue;
+
+        std::vector<long long> counts(table.sums.size(), 0);
+        for (long long d = 0; d < draws; ++d) counts[table.sampler.sample(rng)]++;
+        size_t i = 0;
+        for (const auto& [sum, p] : expected) {
+            CHECK_EQ(table.sums[i], sum);
+            CHECK_NEAR(static_cast<double>(counts[i]) / draws, p, 5.0 * std::sqrt(p * (1.0 - p) / draws) + 1e-9);
+            ++i;
+        }
+    }
+}
@@ -0,0 +1,43 @@
+#include <string>
+#include "GameModule.h"
+#include "MonteCarloSimulator.h"
+#include "TestHarness.h"
+
+using namespace Game;
+
+namespace {
+
+    // What the traced round scored in total.
+    double traceTotal(const RoundTrace& trace) {
+        double total = trace.bg_value;
+        for (const RoundTrace::FGPick& pick : trace.fg_picks) total += pick.value;
+        return total;
+    }
+
+    // Every top-k entry of a run replays to a round with the same total score,
+    // for both memory modes, serial and parallel, and both games.
+    template <typename Module>
+    void checkTopRoundsReplay(MemoryMode mem_mode, bool parallel) {
+        Module::initializeFromJSON(std::string(TEST_DATA_DIR) + "/" + Module::default_config, 1.0, 1.0);
+        MonteCarloSimulator<Module> sim;
+        sim.setSeed(99991);
+        sim.setProgressiveHistogramBins();
+        sim.run(6, 20000, SimulationMode::FULL_GAME, mem_mode, parallel, 0.05);
+        CHECK_EQ(sim.topValues().size(), size_t(5));
+        for (const TopRound& top : sim.topValues()) {
+            const RoundTrace trace = sim.replayRound(top.round);
+            CHECK_NEAR(traceTotal(trace), top.value, 1e-9 * (1.0 + top.value));
+        }
+    }
+
+} // namespace
+
+TEST_CASE(replay_reproduces_top_rounds_ss03) {
+    checkTopRoundsReplay<SS03Module>(MemoryMode::EFFICIENT, false);
+    checkTopRoundsReplay<SS03Module>(MemoryMode::ACCURATE, true);
+}
+
+TEST_CASE(replay_reproduces_top_rounds_deepdive) {
+    checkTopRoundsReplay<DeepDiveModule>(MemoryMode::EFFICIENT, true);
+    checkTopRoundsReplay<DeepDiveModule>(MemoryMode::ACCURATE, false);
+}
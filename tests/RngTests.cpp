@@ -0,0 +1,120 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "Rng.h"
+#include "TestHarness.h"
+
+using namespace Game;
+
+// Known-answer vectors of the Random123 distribution (kat_vectors) for
+// philox4x32_10: counter words, key words, expected output words. Our counter
+// is (block index low, high, stream low, high) and the key is the seed.
+TEST_CASE(rng_philox_known_answers) {
+    struct Vector {
+        uint32_t ctr[4];
+        uint32_t key[2];
+        uint32_t out[4];
+    };
+    const Vector vectors[] = {
+        {{0x00000000u, 0x00000000u, 0x00000000u, 0x00000000u}, {0x00000000u, 0x00000000u},
+         {0x6627e8d5u, 0xe169c58du, 0xbc57ac4cu, 0x9b00dbd8u}},
+        {{0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu}, {0xffffffffu, 0xffffffffu},
+         {0x408f276du, 0x41c83b0eu, 0xa20bc7c6u, 0x6d5451fdu}},
+        {{0x243f6a88u, 0x85a308d3u, 0x13198a2eu, 0x03707344u}, {0xa4093822u, 0x299f31d0u},
+         {0xd16cfe09u, 0x94fdccebu, 0x5001e420u, 0x24126ea1u}},
+    };
+    for (const Vector& v : vectors) {
+        const uint64_t seed = (static_cast<uint64_t>(v.key[1]) << 32) | v.key[0];
+        const uint64_t stream = (static_cast<uint64_t>(v.ctr[3]) << 32) | v.ctr[2];
+        const uint64_t index = (static_cast<uint64_t>(v.ctr[1]) << 32) | v.ctr[0];
+        Philox4x32 rng(seed, stream);
+        uint32_t out[4];
+        rng.block(index, out);
+        for (int w = 0; w < 4; ++w) CHECK_EQ(out[w], v.out[w]);
+    }
+
+    // operator() hands out block 0, 1, ... as two 64-bit draws each.
+    Philox4x32 rng(0, 0);
+    const uint64_t first = rng(), second = rng();
+    CHECK_EQ(first, 0xe169c58d6627e8d5ULL);
+    CHECK_EQ(second, 0x9b00dbd8bc57ac4cULL);
+}
+
+// First outputs of the reference xoshiro256plusplus.c from the state
+// {1, 2, 3, 4}.
+TEST_CASE(rng_xoshiro_reference_outputs) {
+    const uint64_t expected[] = {
+        41943041ULL, 58720359ULL, 3588806011781223ULL, 3591011842654386ULL,
+        9228616714210784205ULL, 9973669472204895162ULL, 14011001112246962877ULL,
+        12406186145184390807ULL, 15849039046786891736ULL, 10450023813501588000ULL,
+    };
+    Xoshiro256pp rng;
+    rng.setState(1, 2, 3, 4);
+    for (uint64_t e : expected) CHECK_EQ(rng(), e);
+}
+
+// Reference splitmix64.c outputs for the seed 1234567, which seed() relies on.
+TEST_CASE(rng_splitmix_reference_outputs) {
+    const uint64_t expected[] = {
+        6457827717110365317ULL, 3203168211198807973ULL, 9817491932198370423ULL,
+        4593380528125082431ULL, 16408922859458223821ULL,
+    };
+    uint64_t state = 1234567;
+    for (uint64_t e : expected) CHECK_EQ(splitMix64(state), e);
+}
+
+// Different streams of one seed start from different states.
+TEST_CASE(rng_streams_differ) {
+    Xoshiro256pp a(7, 0), b(7, 1);
+    Philox4x32 c(7, 0), d(7, 1);
+    CHECK(a() != b());
+    CHECK(c() != d());
+}
+
+TEST_CASE(rng_uniform_unit_range) {
+    Xoshiro256pp rng(5, 0);
+    double lowest = 1.0, highest = 0.0;
+    for (int i = 0; i < 1000000; ++i) {
+        const double u = uniformUnit(rng);
+        lowest = std::min(lowest, u);
+        highest = std::max(highest, u);
+    }
+    CHECK(lowest >= 0.0);
+    CHECK(highest < 1.0);
+    CHECK(lowest < 1e-5);
+    CHECK(highest > 1.0 - 1e-5);
+}
+
+// uniformIndex stays in [0, n), reaches every value of a small range about
+// equally often, and handles the extremes of n.
+TEST_CASE(rng_uniform_index_bounds) {
+    Philox4x32 rng(11, 2);
+    for (int i = 0; i < 1000; ++i) CHECK_EQ(uniformIndex(rng, 1), 0ULL);
+
+    const uint64_t sizes[] = {2, 3, 7, 10, 1000, (1ULL << 32) + 1, (1ULL << 63) + 1,
+                              std::numeric_limits<uint64_t>::max()};
+    for (uint64_t n : sizes) {
+        bool in_range = true;
+        for (int i = 0; i < 100000; ++i) in_range = in_range && uniformIndex(rng, n) < n;
+        CHECK(in_range);
+    }
+
+    const uint64_t n = 7;
+    const long long draws = 700000;
+    std::vector<long long> counts(n, 0);
+    for (long long i = 0; i < draws; ++i) counts[uniformIndex(rng, n)]++;
+    const double p = 1.0 / n;
+    for (long long c : counts) {
+        CHECK_NEAR(static_cast<double>(c) / draws, p, 5.0 * std::sqrt(p * (1.0 - p) / draws));
+    }
+
+    // Just above 2^63 almost half the products fall below the rejection
+    // threshold; the accepted draws must still be uniform over [0, n).
+    const uint64_t big = (1ULL << 63) + 1;
+    const int big_draws = 100000;
+    double sum = 0.0;
+    for (int i = 0; i < big_draws; ++i) sum += static_cast<double>(uniformIndex(rng, big)) / static_cast<double>(big);
+    CHECK_NEAR(sum / big_draws, 0.5, 5.0 * std::sqrt(1.0 / 12.0 / big_draws));
+}
@@ -0,0 +1,141 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "AliasTable.h"
+#include "Rng.h"
+#include "SimdBatch.h"
+#include "TestHarness.h"
+
+using namespace Game;
+
+namespace {
+
+    // Scores as the runners see them: mostly zero, some exact divider
+    // values, negatives, huge values and signed zeros.
+    std::vector<double> sampleScores(size_t n, uint64_t stream) {
+        Xoshiro256pp rng(4242, stream);
+        const double specials[] = {0.0, -0.0, 1.0, 5.0, 20.0, 100.0, 2000.0, -3.0, 1e12, 0.999999};
+        std::vector<double> x(n);
+        for (size_t i = 0; i < n; ++i) {
+            const uint64_t kind = uniformIndex(rng, 4);
+            if (kind == 0) x[i] = 0.0;
+            else if (kind == 1) x[i] = specials[uniformIndex(rng, 10)];
+            else x[i] = std::floor(uniformUnit(rng) * 2500.0) * (kind == 3 ? 0.5 : 1.0);
+        }
+        return x;
+    }
+
+} // namespace
+
+// Every dispatched path of countNonzero agrees with x != 0.0, tails included.
+TEST_CASE(simd_count_nonzero_matches_scalar) {
+    std::vector<double> x = sampleScores(1031, 1);
+    x[7] = std::numeric_limits<double>::quiet_NaN();  // Compares != 0.0
+    for (size_t n : {size_t(0), size_t(1), size_t(3), size_t(8), size_t(17), x.size()}) {
+        const size_t expected = static_cast<size_t>(std::count_if(x.begin(), x.begin() + n, [](double v) { return v != 0.0; }));
+        CHECK_EQ(detail::countNonzeroScalar(x.data(), n), expected);
+        CHECK_EQ(countNonzero(x.data(), n), expected);
+#if GAME_SIMD_X86
+        if (cpuHasSSE42()) CHECK_EQ(detail::countNonzeroSSE42(x.data(), n), expected);
+        if (cpuHasAVX2()) CHECK_EQ(detail::countNonzeroAVX2(x.data(), n), expected);
+        if (cpuHasAVX512()) CHECK_EQ(detail::countNonzeroAVX512(x.data(), n), expected);
+#endif
+    }
+}
+
+// The branchless SIMD searches return std::upper_bound's position for
+// divider tables of every size from one entry up.
+TEST_CASE(simd_upper_bound_matches_std) {
+    const std::vector<double> x = sampleScores(1027, 2);
+    std::vector<double> dividers = {0.0, 1.0};
+    for (double v = 5; v <= 100; v += 5) dividers.push_back(v);
+    for (double v = 200; v <= 2000; v += 100) dividers.push_back(v);
+
+    std::vector<int32_t> expected(x.size()), got(x.size());
+    for (size_t m = 1; m <= dividers.size(); ++m) {
+        for (size_t i = 0; i < x.size(); ++i) {
+            expected[i] = static_cast<int32_t>(std::upper_bound(dividers.begin(), dividers.begin() + m, x[i]) - dividers.begin());
+        }
+        upperBoundBatch(dividers.data(), m, x.data(), x.size(), got.data());
+        CHECK(got == expected);
+#if GAME_SIMD_X86
+        if (cpuHasAVX2()) {
+            detail::upperBoundAVX2(dividers.data(), m, x.data(), x.size(), got.data());
+            CHECK(got == expected);
+        }
+        if (cpuHasAVX512()) {
+            detail::upperBoundAVX512(dividers.data(), m, x.data(), x.size(), got.data());
+            CHECK(got == expected);
+        }
+#endif
+    }
+}
+
+// gatherInt32 reads the same fields as the scalar loop for every output type.
+TEST_CASE(simd_gather_matches_scalar) {
+    struct Record {
+        int32_t a, b, c;
+    };
+    std::vector<Record> records(97);
+    for (size_t r = 0; r < records.size(); ++r) {
+        records[r] = {static_cast<int32_t>(r) * 3 - 50, static_cast<int32_t>(r * r), -static_cast<int32_t>(r)};
+    }
+    Xoshiro256pp rng(8, 0);
+    std::vector<int32_t> ids(1001);
+    for (int32_t& id : ids) id = static_cast<int32_t>(uniformIndex(rng, records.size()));
+
+    const int32_t* fields = reinterpret_cast<const int32_t*>(records.data());
+    const int32_t stride = sizeof(Record) / sizeof(int32_t);
+    std::vector<double> as_double(ids.size());
+    std::vector<long long> as_long(ids.size());
+    std::vector<int32_t> as_int(ids.size());
+    gatherInt32(fields + 1, stride, ids.data(), ids.size(), as_double.data());
+    gatherInt32(fields + 0, stride, ids.data(), ids.size(), as_long.data());
+    gatherInt32(fields + 2, stride, ids.data(), ids.size(), as_int.data());
+    bool same = true;
+    for (size_t i = 0; i < ids.size(); ++i) {
+        const Record& r = records[ids[i]];
+        same = same && as_double[i] == r.b && as_long[i] == r.a && as_int[i] == r.c;
+    }
+    CHECK(same);
+}
+
+// Philox4x32::fillUniform (four blocks per AVX2 step) yields exactly the
+// uniformUnit sequence, also when a call starts or ends inside a block.
+TEST_CASE(simd_philox_fill_uniform_matches_scalar) {
+    Philox4x32 batched(77, 5), scalar(77, 5);
+    std::vector<double> u(300);
+    bool same = true;
+    for (size_t n : {size_t(1), size_t(8), size_t(3), size_t(64), size_t(13), size_t(300), size_t(7)}) {
+        fillUniform(batched, u.data(), n);
+        for (size_t i = 0; i < n; ++i) same = same && u[i] == uniformUnit(scalar);
+    }
+    CHECK(same);
+    CHECK_EQ(batched(), scalar());  // Both left at the same position
+}
+
+// The generic fillUniform falls back to uniformUnit draws.
+TEST_CASE(simd_xoshiro_fill_uniform_matches_scalar) {
+    Xoshiro256pp batched(3, 9), scalar(3, 9);
+    std::vector<double> u(101);
+    fillUniform(batched, u.data(), u.size());
+    bool same = true;
+    for (double v : u) same = same && v == uniformUnit(scalar);
+    CHECK(same);
+}
+
+// AliasTable::sampleBatch returns what sample() returns for the same uniforms.
+TEST_CASE(simd_alias_sample_batch_matches_sample) {
+    AliasTable table;
+    table.build({0.5, 2.0, 0.0, 1.0, 3.5, 0.25, 8.0}, {10, 11, 12, 13, 14, 15, 16});
+    Philox4x32 rng(21, 0), replay(21, 0);
+    std::vector<double> u(1003);
+    fillUniform(rng, u.data(), u.size());
+    std::vector<int32_t> batch(u.size());
+    table.sampleBatch(u.data(), u.size(), batch.data());
+    bool same = true;
+    for (size_t i = 0; i < u.size(); ++i) same = same && batch[i] == table.sample(replay);
+    CHECK(same);
+}
@@ -0,0 +1,91 @@
+#include <cmath>
+#include <string>
+#include "GameModule.h"
+#include "TestHarness.h"
+
+using namespace Game;
+
+namespace {
+
+    // Totals of a run of rounds, counting each inert skipped round as a zero row.
+    struct RunTotals {
+        long long rounds = 0;
+        long long inert = 0;
+        long long triggered = 0;
+        long long nonzero = 0;
+        double sum = 0.0, sum_sq = 0.0;
+
+        void addBlock(const GameResultBlock& block) {
+            rounds += static_cast<long long>(block.size + block.inert_rounds);
+            inert += static_cast<long long>(block.inert_rounds);
+            for (size_t j = 0; j < block.size; ++j) {
+                const double total = block.bg_score[j] + block.fg_score[j];
+                if (block.fg_was_triggered(j)) triggered++;
+                if (total != 0.0) nonzero++;
+                sum += total;
+                sum_sq += total * total;
+            }
+        }
+        double mean() const { return sum / rounds; }
+        double variance() const { return sum_sq / rounds - mean() * mean(); }
+    };
+
+    // Plays the same number of FULL_GAME rounds from the same seed and stream
+    // with and without inert skip-ahead. The two runs consume their draws
+    // differently, so they are compared statistically: the FG trigger and
+    // nonzero rates and the mean score must agree within five standard errors.
+    template <typename Module>
+    void checkSkipMatchesPlain(const std::string& config, double second_chance_prob) {
+        Module::initializeFromJSON(std::string(TEST_DATA_DIR) + "/" + config, 1.0, 1.0);
+        const size_t block_rounds = 10000;
+        const int blocks = 60;
+
+        RunTotals plain, skipped;
+        GameResultBlock block;
+        Xoshiro256pp plain_rng(314159, 4), skip_rng(314159, 4);
+        for (int b = 0; b < blocks; ++b) {
+            Module::template simulateGameRounds<SimulationMode::FULL_GAME, StatsPolicy::FULL>(plain_rng, second_chance_prob,
+                                                                                            block_rounds, block);
+            plain.addBlock(block);
+
+            Module::template simulateGameRoundsSkippingInert<StatsPolicy::FULL>(skip_rng, second_chance_prob, block_rounds, block);
+            CHECK_EQ(block.size + block.inert_rounds, block_rounds);
+            // Rows keep the rounds they stand for: strictly increasing, inside the block.
+            bool ordered = true;
+            for (size_t j = 0; j < block.size; ++j) {
+                ordered = ordered && block.roundOffset(j) < block_rounds && (j == 0 || block.roundOffset(j) > block.roundOffset(j - 1));
+            }
+            CHECK(ordered);
+            skipped.addBlock(block);
+        }
+
+        CHECK_EQ(plain.rounds, skipped.rounds);
+        CHECK(skipped.inert > 0);  // The config must have an inert class for the test to mean anything
+        const double n = static_cast<double>(plain.rounds);
+        auto checkRate = [n](long long a, long long b) {
+            const double p = (a + b) / (2.0 * n);
+            CHECK_NEAR(a / n, b / n, 5.0 * std::sqrt(2.0 * p * (1.0 - p) / n) + 1e-12);
+        };
+        checkRate(plain.triggered, skipped.triggered);
+        checkRate(plain.nonzero, skipped.nonzero);
+        const double std_error = std::sqrt((plain.variance() + skipped.variance()) / n);
+        CHECK_NEAR(plain.mean(), skipped.mean(), 5.0 * std_error);
+    }
+
+} // namespace
+
+TEST_CASE(skip_ahead_matches_plain_ss03) {
+    checkSkipMatchesPlain<SS03Module>(SS03Module::default_config, 0.0);
+}
+
+TEST_CASE(skip_ahead_matches_plain_ss03_second_chance) {
+    checkSkipMatchesPlain<SS03Module>(SS03Module::default_config, 0.3);
+}
+
+TEST_CASE(skip_ahead_matches_plain_deepdive) {
+    checkSkipMatchesPlain<DeepDiveModule>(DeepDiveModule::default_config, 0.0);
+}
+
+TEST_CASE(skip_ahead_matches_plain_deepdive_second_chance) {
+    checkSkipMatchesPlain<DeepDiveModule>(DeepDiveModule::default_config, 0.3);
+}
@@ -0,0 +1,77 @@
+#ifndef TEST_HARNESS_H
+#define TEST_HARNESS_H
+
+// Minimal self-registering test harness, so the tests build with nothing but
+// the compiler. TEST_CASE(name) defines a test; CHECK, CHECK_EQ and
+// CHECK_NEAR report a failure and let the test carry on. The test binary runs
+// every test whose name starts with its first argument (all of them without
+// one) and exits nonzero if any check failed.
+
+#include <cmath>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace TestHarness {
+
+    struct TestCase {
+        const char* name;
+        void (*fn)();
+    };
+
+    inline std::vector<TestCase>& registry() {
+        static std::vector<TestCase> tests;
+        return tests;
+    }
+
+    inline int& failureCount() {
+        static int failures = 0;
+        return failures;
+    }
+
+    struct Registrar {
+        Registrar(const char* name, void (*fn)()) { registry().push_back({name, fn}); }
+    };
+
+    inline void fail(const char* file, int line, const std::string& what) {
+        std::cerr << file << ":" << line << ": check failed: " << what << std::endl;
+        ++failureCount();
+    }
+
+} // namespace TestHarness
+
+#define TEST_CASE(name)                                                     \
+    static void name();                                                     \
+    static const TestHarness::Registrar name##_registrar(#name, &name);     \
+    static void name()
+
+#define CHECK(cond)                                                         \
+    do {                                                                    \
+        if (!(cond)) TestHarness::fail(__FILE__, __LINE__, #cond);          \
+    } while (0)
+
+#define CHECK_EQ(a, b)                                                      \
+    do {                                                                    \
+        const auto& check_a_ = (a);                                         \
+        const auto& check_b_ = (b);                                         \
+        if (!(check_a_ == check_b_)) {                                      \
+            std::ostringstream check_msg_;                                  \
+            check_msg_ << #a " == " #b " (" << check_a_ << " vs " << check_b_ << ")"; \
+            TestHarness::fail(__FILE__, __LINE__, check_msg_.str());        \
+        }                                                                   \
+    } while (0)
+
+#define CHECK_NEAR(a, b, tol)                                               \
+    do {                                                                    \
+        const double check_a_ = (a);                                        \
+        const double check_b_ = (b);                                        \
+        if (!(std::fabs(check_a_ - check_b_) <= (tol))) {                   \
+            std::ostringstream check_msg_;                                  \
+            check_msg_ << #a " ~= " #b " (" << check_a_ << " vs " << check_b_ \
+                       << ", tolerance " << (tol) << ")";                   \
+            TestHarness::fail(__FILE__, __LINE__, check_msg_.str());        \
+        }                                                                   \
+    } while (0)
+
+#endif // TEST_HARNESS_H
@@ -0,0 +1,23 @@
+#include <iostream>
+#include <string>
+#include "TestHarness.h"
+
+// Runs the registered tests whose name starts with argv[1] (every test when
+// no prefix is given). ctest runs one prefix per test file.
+int main(int argc, char* argv[]) {
+    const std::string prefix = argc > 1 ? argv[1] : "";
+    int run = 0;
+    for (const TestHarness::TestCase& test : TestHarness::registry()) {
+        if (std::string(test.name).compare(0, prefix.size(), prefix) != 0) continue;
+        const int failures_before = TestHarness::failureCount();
+        test.fn();
+        std::cout << (TestHarness::failureCount() == failures_before ? "[PASS] " : "[FAIL] ") << test.name << std::endl;
+        ++run;
+    }
+    if (run == 0) {
+        std::cerr << "No test matches '" << prefix << "'." << std::endl;
+        return 1;
+    }
+    std::cout << run << " test(s), " << TestHarness::failureCount() << " failed check(s)." << std::endl;
+    return TestHarness::failureCount() == 0 ? 0 : 1;
+}